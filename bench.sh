@@ -0,0 +1,100 @@
+#!/usr/bin/env bash
+# Time the solver of every binary on every solver, print the median and the minimum
+# of the runs with the delta to the first binary, and write the path of the fastest
+# binary in build/fastest. Only the time reported by the solver is measured, not
+# the process startup nor the printing. A binary only replaces the first one when
+# both its median and minimum totals are lower by more than NOISE percent, and no
+# solver has a median higher by more than NOISE percent.
+# Usage : ./bench.sh binary... (RUNS=n to change the number of runs, NOISE=p the margin)
+
+RUNS=${RUNS:-7}
+NOISE=${NOISE:-3}
+SOLVERS=("-s" "-d" "-S" "-P" "-r 1")
+# Inputs on which each solver searches for tens to hundreds of milliseconds
+declare -A INPUT=(["-s"]=bench_grid/7x7.txt ["-d"]=bench_grid/8x8.txt ["-S"]=bench_grid/6x6.txt
+                  ["-P"]=bench_grid/7x7.txt ["-r 1"]=bench_grid/7x7.txt)
+BINARIES=("$@")
+
+# Solver time in milliseconds, read from the stderr of the machine output
+solver_time() {
+    # shellcheck disable=SC2086
+    "$1" $2 -o machine -f "$3" 2>&1 > /dev/null | awk '/Time taken by solver/ { print $(NF - 1); found = 1 } END { exit !found }'
+}
+
+# Median and minimum of the arguments
+stats() {
+    printf "%s\n" "$@" | sort -g | awk '{ v[NR] = $1 } END { print (NR % 2 ? v[(NR + 1) / 2] : (v[NR / 2] + v[NR / 2 + 1]) / 2), v[1] }'
+}
+
+# Delta in percent of $1 to $2
+delta() {
+    awk -v a="$1" -v b="$2" 'BEGIN { print (b > 0 ? (a - b) * 100 / b : 0) }'
+}
+
+declare -A median_total min_total slower
+printf "%-8s" "solver"
+for binary in "${BINARIES[@]}"; do
+    printf "%30s" "$binary"
+    median_total[$binary]=0
+    min_total[$binary]=0
+    slower[$binary]=0
+done
+printf "\n%-8s" ""
+for binary in "${BINARIES[@]}"; do
+    printf "%30s" "median (min) ms"
+done
+printf "\n"
+
+for solver in "${SOLVERS[@]}"; do
+    declare -A samples=()
+    # The binaries take turns on every run, so a drift of the machine hits all of them
+    for ((run = 0; run < RUNS; run++)); do
+        for binary in "${BINARIES[@]}"; do
+            time=$(solver_time "$binary" "$solver" "${INPUT[$solver]}") || exit 1
+            samples[$binary]+="$time "
+        done
+    done
+
+    printf "%-8s" "$solver"
+    base=""
+    for binary in "${BINARIES[@]}"; do
+        # shellcheck disable=SC2086
+        read -r median min <<< "$(stats ${samples[$binary]})"
+        median_total[$binary]=$(awk -v a="${median_total[$binary]}" -v b="$median" 'BEGIN { print a + b }')
+        min_total[$binary]=$(awk -v a="${min_total[$binary]}" -v b="$min" 'BEGIN { print a + b }')
+        if [ -z "$base" ]; then
+            base=$median
+            printf "%22.2f (%.2f)" "$median" "$min"
+        else
+            change=$(delta "$median" "$base")
+            printf "%14.2f (%.2f) %+6.1f%%" "$median" "$min" "$change"
+            if awk -v c="$change" -v noise="$NOISE" 'BEGIN { exit !(c > noise) }'; then
+                slower[$binary]=$(( slower[$binary] + 1 ))
+            fi
+        fi
+    done
+    printf "\n"
+    unset samples
+done
+
+first=${BINARIES[0]}
+fastest=$first
+printf "%-8s" "total"
+for binary in "${BINARIES[@]}"; do
+    if [ "$binary" = "$first" ]; then
+        printf "%22.2f (%.2f)" "${median_total[$binary]}" "${min_total[$binary]}"
+        continue
+    fi
+    printf "%14.2f (%.2f) %+6.1f%%" "${median_total[$binary]}" "${min_total[$binary]}" "$(delta "${median_total[$binary]}" "${median_total[$first]}")"
+    if [ "${slower[$binary]}" -eq 0 ] && awk -v m="${median_total[$binary]}" -v n="${min_total[$binary]}" -v fm="${median_total[$fastest]}" -v fn="${min_total[$fastest]}" -v noise="$NOISE" \
+        'BEGIN { exit !(m < fm * (1 - noise / 100) && n < fn * (1 - noise / 100)) }'; then
+        fastest=$binary
+    fi
+done
+if [ "$fastest" = "$first" ]; then
+    printf "\n\nNo build beats %s by more than %s%% without a slower solver\n" "$first" "$NOISE"
+else
+    printf "\n\nFastest build: %s\n" "$fastest"
+fi
+mkdir -p build
+echo "$fastest" > build/fastest
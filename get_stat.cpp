@@ -12,6 +12,9 @@
 #include <fstream>
 #include <chrono>
 #include <map>
+#include <thread>
+#include <random>
+#include <algorithm>
 #include "src/MacMahonGame/MacMahonGame.hpp"
 
 constexpr std::string_view PROGNAME = "MacMahon Solver";
@@ -30,10 +33,185 @@ auto failure = [](std::string_view message) {
     std::cerr << "❌ Error: " << message << " ❌\n";
 };
 
+/**
+ * @brief A solvable 7x7 puzzle with three inner colors, seconds of backtracking for the
+ * plain solver. Random inner edges around a 'B' frame, tiles shuffled.
+ */
+Puzzle longPuzzle(unsigned int seed) {
+    constexpr int size = 7;
+    const std::string inner = "RGY";
+    std::mt19937 random(seed);
+    auto color = [&](bool frame) { return frame ? 'B' : inner[random() % inner.size()]; };
+    std::vector<std::vector<char>> vertical(size, std::vector<char>(size + 1)), horizontal(size + 1, std::vector<char>(size));
+    for (int row = 0; row < size; row++)
+        for (int col = 0; col <= size; col++)
+            vertical[row][col] = color(col == 0 || col == size);
+    for (int row = 0; row <= size; row++)
+        for (int col = 0; col < size; col++)
+            horizontal[row][col] = color(row == 0 || row == size);
+    std::vector<Tile> tiles;
+    for (int row = 0; row < size; row++)
+        for (int col = 0; col < size; col++)
+            tiles.emplace_back(vertical[row][col], horizontal[row][col], vertical[row][col + 1], horizontal[row + 1][col]);
+    std::shuffle(tiles.begin(), tiles.end(), random);
+    return Puzzle(size, size, tiles);
+}
+
+/**
+ * @brief Puzzles per second on a mixed workload : the grid/ puzzles many times, plus one
+ * long puzzle every round that must not hold the short ones back. The long puzzle runs
+ * once at a lower priority with its own deadline, once at the same priority and deadline
+ * as the short ones, where only the fewest slices rule lets the short ones through.
+ */
+int runThroughput(int rounds) {
+    const std::vector<std::string> shortPuzzles = {"./grid/4x4.txt", "./grid/5x5.txt", "./grid/6x6.txt", "./bad_grid/6x4.txt"};
+    const unsigned int workers = std::max(1u, std::thread::hardware_concurrency());
+    using Clock = std::chrono::steady_clock;
+
+    // Baseline : one fresh thread per puzzle, hardware_concurrency at a time, without the long puzzle
+    std::vector<std::string> workload;
+    for (int round = 0; round < rounds; round++)
+        workload.insert(workload.end(), shortPuzzles.begin(), shortPuzzles.end());
+    auto start = Clock::now();
+    for (size_t first = 0; first < workload.size(); first += workers) {
+        std::vector<std::thread> threads;
+        for (size_t i = first; i < std::min(workload.size(), first + workers); i++) {
+            threads.emplace_back([&workload, i] {
+                MacMahonGame game(workload[i]);
+                game.solve();
+            });
+        }
+        for (std::thread &thread : threads)
+            thread.join();
+    }
+    std::chrono::duration<double> threaded = Clock::now() - start;
+    std::cout << "Thread per puzzle: " << workload.size() / threaded.count() << " puzzles/s (" << workload.size() << " puzzles)" << std::endl;
+
+    // Scheduler : the same puzzles, then again with the long puzzle cut by its deadline
+    enum class Mix { None, LowerPriority, EqualPriority };
+    for (Mix mix : {Mix::None, Mix::LowerPriority, Mix::EqualPriority}) {
+        start = Clock::now();
+        PuzzleScheduler scheduler(workers, 4096);
+        std::vector<std::unique_ptr<MacMahonGame>> games;
+        std::vector<std::size_t> ids;
+        std::vector<bool> isShort;
+        int shortPriority = mix == Mix::LowerPriority ? 1 : 0;
+        Clock::time_point shortDeadline = mix == Mix::EqualPriority ? start + std::chrono::seconds(2) : Clock::time_point::max();
+        for (int round = 0; round < rounds; round++) {
+            if (mix != Mix::None) {
+                games.push_back(std::make_unique<MacMahonGame>(longPuzzle(round)));
+                Clock::time_point deadline = mix == Mix::EqualPriority ? shortDeadline : Clock::now() + std::chrono::milliseconds(100);
+                ids.push_back(games.back()->schedule(scheduler, 0, deadline));
+                isShort.push_back(false);
+            }
+            for (const std::string &path : shortPuzzles) {
+                games.push_back(std::make_unique<MacMahonGame>(path));
+                ids.push_back(games.back()->schedule(scheduler, shortPriority, shortDeadline));
+                isShort.push_back(true);
+            }
+        }
+        scheduler.wait();
+        std::chrono::duration<double> elapsed = Clock::now() - start;
+
+        int solved = 0, expired = 0;
+        std::chrono::duration<double, std::milli> shortLatency{0};
+        for (size_t i = 0; i < ids.size(); i++) {
+            const ScheduledResult &result = scheduler.getResult(ids[i]);
+            solved += games[i]->collect(result);
+            expired += result.status == SearchStatus::Cancelled;
+            if (isShort[i])
+                shortLatency += result.elapsed;
+        }
+        const char *label = mix == Mix::None ? "" : mix == Mix::LowerPriority ? " (mixed, long puzzle at a lower priority)" : " (mixed, equal priority and deadline)";
+        std::cout << "Coroutine scheduler" << label << ": " << ids.size() / elapsed.count() << " puzzles/s ("
+                  << ids.size() << " puzzles, " << solved << " solved, " << expired << " past their deadline), "
+                  << "short puzzles done after " << shortLatency.count() / workload.size() << "ms on average" << std::endl;
+    }
+    return 0;
+}
+
+/**
+ * @brief Local repair against a full re-solve : every edit recolors a random inner edge of the
+ * current solution, the two tiles sharing it are replaced one at a time (replaceTile, or
+ * removeTile then addTile every other edit) and the game is re-solved by solve_incremental.
+ * The full re-solve is a fresh search of the edited tile set.
+ */
+int runIncremental(int edits) {
+    const std::vector<std::string> puzzles = {"./grid/4x4.txt", "./grid/5x5.txt", "./grid/6x6.txt"};
+    std::mt19937 random(1);
+    // Input index of a copy of the tile, other than skip
+    auto indexOf = [](const MacMahonGame &game, const Tile &tile, int skip) {
+        const std::vector<Tile> &tiles = game.getTiles();
+        for (size_t i = 0; i < tiles.size(); i++)
+            if (static_cast<int>(i) != skip && tiles[i].left == tile.left && tiles[i].top == tile.top && tiles[i].right == tile.right && tiles[i].bottom == tile.bottom)
+                return static_cast<int>(i);
+        return -1;
+    };
+
+    for (const std::string &path : puzzles) {
+        MacMahonGame game(path);
+        if (!game.solve_incremental()) {
+            failure("No solution for " + path);
+            continue;
+        }
+        const Puzzle original(path);
+        const int rows = original.getRows(), cols = original.getCols();
+        std::string inner;
+        for (const std::vector<Tile> &row : game.getResult())
+            for (size_t col = 0; col + 1 < row.size(); col++)
+                if (inner.find(row[col].right) == std::string::npos)
+                    inner += row[col].right;
+
+        int solved = 0;
+        uint64_t incrementalNodes = 0, fullNodes = 0;
+        std::map<int, int> radii;
+        for (int edit = 0; edit < edits; edit++) {
+            // Horizontal neighbours (row, col) and (row, col + 1), the new color is another inner one
+            int row = random() % rows, col = random() % (cols - 1);
+            Tile left = game.getResult()[row][col], right = game.getResult()[row][col + 1];
+            char color = inner[random() % inner.size()];
+            if (color == left.right)
+                color = inner[(inner.find(color) + 1) % inner.size()];
+            Tile newLeft = left, newRight = right;
+            newLeft.right = newRight.left = color;
+            int leftIndex = indexOf(game, left, -1);
+            int rightIndex = indexOf(game, right, leftIndex);
+            if (edit % 2 == 0) {
+                game.replaceTile(leftIndex, newLeft);
+                game.replaceTile(rightIndex, newRight);
+            } else {
+                game.removeTile(std::max(leftIndex, rightIndex));
+                game.removeTile(std::min(leftIndex, rightIndex));
+                game.addTile(newLeft);
+                game.addTile(newRight);
+            }
+
+            solved += game.solve_incremental();
+            incrementalNodes += game.getNodes();
+            radii[game.getRepairRadius()]++;
+
+            SolverContext context;
+            solvePuzzle(Puzzle(rows, cols, game.getTiles()), context);
+            fullNodes += context.nodes;
+        }
+
+        std::cout << path << ": " << solved << "/" << edits << " edits solved, " << incrementalNodes / double(edits) << " nodes per repair against "
+                  << fullNodes / double(edits) << " per full re-solve, radius";
+        for (const auto &[radius, count] : radii)
+            std::cout << " " << (radius < 0 ? std::string("full") : std::to_string(radius)) << ":" << count;
+        std::cout << std::endl;
+    }
+    return 0;
+}
+
 int main(int argc, char **argv) {
     std::cout << "🤗 |Welcome in " << PROGNAME << " mode| 🤗\n";
     print_release();
     std::cout << "\n\n";
+    if (argc > 1 && std::string(argv[1]) == "--throughput")
+        return runThroughput(argc > 2 ? std::stoi(argv[2]) : 100);
+    if (argc > 1 && std::string(argv[1]) == "--incremental")
+        return runIncremental(argc > 2 ? std::stoi(argv[2]) : 100);
     std::map<std::string, std::vector<double>> fileDurations;
     std::filesystem::path directoryPath = std::string("./grid/");;
     constexpr int iterations = 1000;
@@ -17,6 +17,7 @@
 #include <fstream>
 #include <stdlib.h>
 #include <chrono>
+#include <memory>
 #include "src/MacMahonGame/MacMahonGame.hpp"
 
 std::string PROGNAME="MacMahon Solver";
@@ -40,13 +41,27 @@ auto failure = [](std::string_view message) {
 auto print_usage = []()  {
         std::cout << std::endl 
         << PROGNAME << " by " << AUTHOR << std::endl 
-        << "\033[1mUsage: \033[0m"<< FILE_NAME <<" | [-h | --help] | [-v | --version] | [-V | --verbose] | [-s | --seq] | [-t | --threadpool] | [-p | --parallel-recursion] & [-f | --file] filename" << std::endl
+        << "\033[1mUsage: \033[0m"<< FILE_NAME <<" | [-h | --help] | [-v | --version] | [-V | --verbose] | [-s | --seq] | [-t | --threadpool] | [-p | --parallel-recursion] | [-P | --portfolio] | [-d | --dlx] | [-S | --sat] | [-x | --export-cnf] cnffile | [-r | --restart] seed | [--geometric] | [--nogoods] | [-c | --cache] cachefile | [-y | --symmetry] | [-m | --memo] MiB | [--memo-policy always|depth|twotier] | [-a | --all] | [-o | --output] color|plain|machine | [-e | --expand] & [-f | --file] filename" << std::endl
         << "          -h            help" << std::endl
         << "          -v            Version" << std::endl
         << "          -v            Verbose" << std::endl
         << "          -s            Execute the sequential solver (by default)" << std::endl
         << "          -t            Execute the threadpool solver" << std::endl
         << "          -p            Execute the parallel recusion solver" << std::endl
+        << "          -P            Execute the portfolio solver (several configurations race)" << std::endl
+        << "          -d            Execute the exact cover solver (Dancing Links)" << std::endl
+        << "          -S            Execute the SAT solver (CDCL) on the CNF encoding of the puzzle" << std::endl
+        << "          -x cnffile    Write the CNF encoding of the puzzle in the DIMACS format before solving" << std::endl
+        << "          -r seed       Execute the randomized restarts solver (Luby schedule)" << std::endl
+        << "          --geometric   Geometric restart schedule instead of Luby (with -r)" << std::endl
+        << "          --nogoods     Keep the dead subproblems between restarts (with -r)" << std::endl
+        << "          -c cachefile Reuse the outcome of already solved puzzles" << std::endl
+        << "          -y           Also reuse the outcome of a rotated puzzle (with -c)" << std::endl
+        << "          -m MiB       Memoize dead subproblems in a table of MiB megabytes" << std::endl
+        << "          --memo-policy Replacement policy of the memo table (twotier by default)" << std::endl
+        << "          -a           Count every solution (sequential solver, or exact cover solver with -d)" << std::endl
+        << "          -e           Count the copies of an identical tile as different solutions (with -a)" << std::endl
+        << "          -o mode      Draw the tiles with colors (by default), plain letters or in the input file format" << std::endl
         << "          -f filename  'number.txt' by default" << std::endl;
 };
 
@@ -60,8 +75,18 @@ auto print_help  = []()  {
 };
 
 int main(int argc,char** argv){
-    std::cout << "🤗  |Welcome in \033[1m" << PROGNAME << "\033[0m mode| 🤗" << std::endl; print_release(); std::cout << std::endl << std::endl;
     std::string filename = "";
+    std::string cachePath = "";
+    bool symmetric = false;
+    std::size_t memoMiB = 0;
+    ReplacementPolicy memoPolicy = ReplacementPolicy::TwoTier;
+    bool countAll = false;
+    RenderMode renderMode = RenderMode::Color;
+    uint64_t seed = 1;
+    RestartSchedule schedule = RestartSchedule::Luby;
+    bool keepNogoods = false;
+    bool expand = false;
+    std::string cnfPath = "";
     int solver = 0;
     // Arg parser
     if(argc < 2) // number of arg minimum 
@@ -82,13 +107,59 @@ int main(int argc,char** argv){
             if(!file.good()) {
                 failure("File not found: " + filename);
             }
-            std::cout << " ✔ | \033[1mFile successfuly load\033[0m | ✔ " << std::endl << std::endl;
         } else if (!strcmp(argv[i] , "-s") || !strcmp(argv[i] , "--seq")){
             solver = 0;
         } else if (!strcmp(argv[i] , "-t") || !strcmp(argv[i] , "--threadpool")){
             solver = 1;
         } else if (!strcmp(argv[i] , "-p") || !strcmp(argv[i] , "--parallel-recursion")){
             solver = 2;
+        } else if (!strcmp(argv[i] , "-P") || !strcmp(argv[i] , "--portfolio")){
+            solver = 3;
+        } else if (!strcmp(argv[i] , "-d") || !strcmp(argv[i] , "--dlx")){
+            solver = 5;
+        } else if (!strcmp(argv[i] , "-S") || !strcmp(argv[i] , "--sat")){
+            solver = 6;
+        } else if (!strcmp(argv[i] , "-x") || !strcmp(argv[i] , "--export-cnf")){
+            cnfPath = argv[++i];
+        } else if (!strcmp(argv[i] , "-r") || !strcmp(argv[i] , "--restart")){
+            solver = 4;
+            seed = std::stoull(argv[++i]);
+        } else if (!strcmp(argv[i] , "--geometric")){
+            schedule = RestartSchedule::Geometric;
+        } else if (!strcmp(argv[i] , "--nogoods")){
+            keepNogoods = true;
+        } else if (!strcmp(argv[i] , "-c") || !strcmp(argv[i] , "--cache")){
+            cachePath = argv[++i];
+        } else if (!strcmp(argv[i] , "-y") || !strcmp(argv[i] , "--symmetry")){
+            symmetric = true;
+        } else if (!strcmp(argv[i] , "-m") || !strcmp(argv[i] , "--memo")){
+            memoMiB = std::stoul(argv[++i]);
+        } else if (!strcmp(argv[i] , "-a") || !strcmp(argv[i] , "--all")){
+            countAll = true;
+        } else if (!strcmp(argv[i] , "-e") || !strcmp(argv[i] , "--expand")){
+            expand = true;
+        } else if (!strcmp(argv[i] , "-o") || !strcmp(argv[i] , "--output")){
+            std::string mode = argv[++i];
+            if(mode == "color"){
+                renderMode = RenderMode::Color;
+            } else if(mode == "plain"){
+                renderMode = RenderMode::Plain;
+            } else if(mode == "machine"){
+                renderMode = RenderMode::Machine;
+            } else {
+                failure("Unknow output mode : " + mode);
+            }
+        } else if (!strcmp(argv[i] , "--memo-policy")){
+            std::string policy = argv[++i];
+            if(policy == "always"){
+                memoPolicy = ReplacementPolicy::AlwaysReplace;
+            } else if(policy == "depth"){
+                memoPolicy = ReplacementPolicy::DepthPreferred;
+            } else if(policy == "twotier"){
+                memoPolicy = ReplacementPolicy::TwoTier;
+            } else {
+                failure("Unknow memo policy : " + policy);
+            }
         } else { // ALL OTHER ARGUMENT
             print_usage();
             std::string arg = argv[i];
@@ -98,38 +169,136 @@ int main(int argc,char** argv){
     }
 
 
+    // Only the sequential and the exact cover solvers can count the solutions
+    if(countAll && solver != 0 && solver != 5){
+        failure("-a counts with the sequential solver (-s) or the exact cover solver (-d), not with -t, -p, -P, -S or -r");
+        return 1;
+    }
+
     /**
      * Begining of the main
      */
-    MacMahonGame myGame =  MacMahonGame(filename);
+    // The machine output only holds the answer for scripts, everything else goes to stderr
+    bool machine = renderMode == RenderMode::Machine;
+    std::ostream &info = machine ? std::cerr : std::cout;
+    if(!machine){
+        std::cout << "🤗  |Welcome in \033[1m" << PROGNAME << "\033[0m mode| 🤗" << std::endl; print_release(); std::cout << std::endl << std::endl;
+    }
+
+    std::unique_ptr<MacMahonGame> game;
+    try {
+        game = std::make_unique<MacMahonGame>(filename);
+    } catch (const std::exception &e) {
+        // Malformed file, Puzzle explains why
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    MacMahonGame &myGame = *game;
+    myGame.setRenderMode(renderMode);
+
+    if(!machine){
+        std::cout << " ✔ | \033[1mFile successfuly load\033[0m | ✔ " << std::endl << std::endl;
+        myGame.print();
+    }
+
+    if(!cnfPath.empty() && !myGame.export_cnf(cnfPath)){
+        failure("Cannot write the CNF file: " + cnfPath);
+    }
 
-    myGame.print();
+    std::string winner = "";
+    auto runSolver = [&]() {
+        if(solver == 3){
+            return myGame.solve_portfolio(winner);
+        }
+        if(solver == 5){
+            return myGame.solve_dlx();
+        }
+        if(solver == 6){
+            return myGame.solve_sat();
+        }
+        if(solver == 4){
+            return myGame.solve_restart(seed, schedule, 1000, keepNogoods);
+        }
+        if(solver == 1){
+            return myGame.solve_thread();
+        }
+        if(solver == 2){
+            return myGame.solve_parallel(500);
+        }
+        return myGame.solve();
+    };
+    std::unique_ptr<DeadStateTable> deadStates;
+    if(memoMiB > 0){
+        deadStates = std::make_unique<DeadStateTable>(memoMiB << 20, memoPolicy);
+        myGame.setDeadStateTable(deadStates.get());
+    }
+    std::unique_ptr<SolutionCache> cache;
+    if(!cachePath.empty()){
+        cache = std::make_unique<SolutionCache>(1024, cachePath);
+    }
     
     auto start = std::chrono::high_resolution_clock::now();
 
     bool result = false;
-    if(solver == 0){
-        result = myGame.solve();
-    }
-    if(solver == 1){
-        result = myGame.solve_thread();
-    }
-    if(solver == 2){
-        result = myGame.solve_parallel(500);
+    unsigned long long solutionCount = 0;
+    FeasibilityReport feasibility = myGame.checkFeasibility();
+    if(!feasibility.feasible()){
+        // Nothing to search, the puzzle has no solution
+    } else if(countAll){
+        auto counter = [&](bool expandCopies) {
+            return solver == 5 ? myGame.count_dlx(expandCopies) : myGame.count_solutions(expandCopies);
+        };
+        solutionCount = cache ? myGame.count_cached(*cache, counter, expand, symmetric) : counter(expand);
+    } else if(cache){
+        result = myGame.solve_cached(*cache, runSolver, symmetric);
+    } else {
+        result = runSolver();
     }
 
     auto end = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double, std::milli> duration = end - start;
 
-    std::cout << "-----------------------------------------------------------------------------------" << std::endl;
-
-    if (result){
-        myGame.printResult();
+    if (machine){
+        // One board, or one status line : UNSAT [reason], UNKNOWN when the search stopped on a budget, COUNT n
+        if (!feasibility.feasible()){
+            std::cout << "UNSAT " << feasibility.reason << std::endl;
+        } else if (countAll){
+            std::cout << "COUNT " << solutionCount << std::endl;
+        } else if (result){
+            myGame.printResult();
+        } else {
+            std::cout << (myGame.wasExhaustive() ? "UNSAT" : "UNKNOWN") << std::endl;
+        }
     } else {
-        std::cout << "No solution found !" << std::endl;
-    } 
+        std::cout << "-----------------------------------------------------------------------------------" << std::endl;
 
-    std::cout << "Time taken by solver (for " << filename << "): " << duration.count() << " microseconds" << std::endl;
+        if (countAll){
+            std::cout << "Number of solutions: " << solutionCount << std::endl;
+        } else if (result){
+            myGame.printResult();
+        } else {
+            std::cout << "No solution found !" << std::endl;
+        }
+        if (!feasibility.feasible()){
+            std::cout << "Infeasible puzzle: " << feasibility.reason << std::endl;
+        }
+    }
+
+    info << "Time taken by solver (for " << filename << "): " << duration.count() << " microseconds" << std::endl;
+    if(solver == 4 && VERBOSE){
+        info << "Restarts: " << myGame.getRestarts() << ", nodes: " << myGame.getNodes() << std::endl;
+    }
+    if(!winner.empty()){
+        info << "Portfolio winner: " << winner << std::endl;
+    }
+    if(deadStates && VERBOSE){
+        info << "Memo: " << deadStates->getProbes() << " probe(s), hit rate " << deadStates->hitRate() * 100 << "%, "
+                  << deadStates->getStores() << " store(s), " << deadStates->getReplacements() << " replacement(s), "
+                  << deadStates->capacity() << " slot(s)" << std::endl;
+    }
+    if(cache && VERBOSE){
+        info << "Cache: " << cache->getHits() << " hit(s), " << cache->getMisses() << " miss(es), " << cache->size() << " puzzle(s) stored" << std::endl;
+    }
 
     return 0;
 }
@@ -0,0 +1,193 @@
+#include "DancingLinks.hpp"
+
+/**
+ * @brief Construct an empty exact cover matrix
+ *
+ * @param primary Number of primary columns, numbered from 0
+ * @param secondary Number of secondary columns, numbered after the primary ones
+ */
+DancingLinks::DancingLinks(int primary, int secondary)
+{
+    // Node 0 is the root, nodes 1..primary+secondary are the column headers
+    int headers = primary + secondary + 1;
+    left.resize(headers);
+    right.resize(headers);
+    up.resize(headers);
+    down.resize(headers);
+    column.resize(headers);
+    row.assign(headers, -1);
+    size.assign(headers, 0);
+    for (int node = 0; node < headers; node++)
+    {
+        up[node] = down[node] = column[node] = node;
+        // Secondary headers stay out of the root list, they never need to be covered
+        left[node] = right[node] = node;
+        if (node <= primary)
+        {
+            left[node] = node == 0 ? primary : node - 1;
+            right[node] = node == primary ? 0 : node + 1;
+        }
+    }
+}
+
+/**
+ * @brief Add a row covering some columns
+ *
+ * @param columns Column indexes, each at most once
+ * @param row_id Returned in the solution when this row is selected
+ */
+void DancingLinks::addRow(const std::vector<int> &columns, int row_id)
+{
+    int first = -1;
+    for (int col : columns)
+    {
+        int header = col + 1;
+        int node = static_cast<int>(column.size());
+        column.push_back(header);
+        row.push_back(row_id);
+        up.push_back(up[header]);
+        down.push_back(header);
+        down[up[header]] = node;
+        up[header] = node;
+        size[header]++;
+        if (first < 0)
+        {
+            first = node;
+            left.push_back(node);
+            right.push_back(node);
+        }
+        else
+        {
+            left.push_back(left[first]);
+            right.push_back(first);
+            right[left[first]] = node;
+            left[first] = node;
+        }
+    }
+}
+
+void DancingLinks::cover(int col)
+{
+    right[left[col]] = right[col];
+    left[right[col]] = left[col];
+    for (int i = down[col]; i != col; i = down[i])
+    {
+        for (int j = right[i]; j != i; j = right[j])
+        {
+            up[down[j]] = up[j];
+            down[up[j]] = down[j];
+            size[column[j]]--;
+        }
+    }
+}
+
+void DancingLinks::uncover(int col)
+{
+    for (int i = up[col]; i != col; i = up[i])
+    {
+        for (int j = left[i]; j != i; j = left[j])
+        {
+            size[column[j]]++;
+            up[down[j]] = j;
+            down[up[j]] = j;
+        }
+    }
+    right[left[col]] = col;
+    left[right[col]] = col;
+}
+
+/**
+ * @brief Primary column with the fewest rows (Knuth's S heuristic)
+ *
+ * @return int header node, 0 when every primary column is covered
+ */
+int DancingLinks::chooseColumn() const
+{
+    int best = 0;
+    for (int col = right[0]; col != 0; col = right[col])
+    {
+        if (best == 0 || size[col] < size[best])
+        {
+            best = col;
+            if (size[col] == 0)
+                break;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Find one exact cover
+ *
+ * @param solution Filled with the row ids of the cover
+ * @return true if there is a solution
+ */
+bool DancingLinks::solve(std::vector<int> &solution)
+{
+    partial.clear();
+    solution.clear();
+    return search(solution);
+}
+
+bool DancingLinks::search(std::vector<int> &solution)
+{
+    int col = chooseColumn();
+    if (col == 0)
+    {
+        solution = partial;
+        return true;
+    }
+    if (size[col] == 0)
+        return false;
+
+    cover(col);
+    for (int i = down[col]; i != col; i = down[i])
+    {
+        partial.push_back(row[i]);
+        for (int j = right[i]; j != i; j = right[j])
+            cover(column[j]);
+        bool found = search(solution);
+        for (int j = left[i]; j != i; j = left[j])
+            uncover(column[j]);
+        partial.pop_back();
+        if (found)
+        {
+            uncover(col);
+            return true;
+        }
+    }
+    uncover(col);
+    return false;
+}
+
+/**
+ * @brief Count every exact cover
+ *
+ * @return unsigned long long
+ */
+unsigned long long DancingLinks::count()
+{
+    return countFrom();
+}
+
+unsigned long long DancingLinks::countFrom()
+{
+    int col = chooseColumn();
+    if (col == 0)
+        return 1;
+    if (size[col] == 0)
+        return 0;
+
+    unsigned long long total = 0;
+    cover(col);
+    for (int i = down[col]; i != col; i = down[i])
+    {
+        for (int j = right[i]; j != i; j = right[j])
+            cover(column[j]);
+        total += countFrom();
+        for (int j = left[i]; j != i; j = left[j])
+            uncover(column[j]);
+    }
+    uncover(col);
+    return total;
+}
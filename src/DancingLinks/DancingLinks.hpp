@@ -0,0 +1,26 @@
+#pragma once
+#include <vector>
+
+// Knuth's Algorithm X with dancing links. Nodes live in parallel int arrays
+// instead of heap allocated structs, so covering a column walks contiguous memory.
+// Primary columns must be covered exactly once, secondary columns at most once.
+class DancingLinks
+{
+public:
+    DancingLinks(int primary, int secondary);
+
+    void addRow(const std::vector<int> &columns, int row_id);
+    bool solve(std::vector<int> &solution);
+    unsigned long long count();
+
+private:
+    std::vector<int> left, right, up, down, column, row;
+    std::vector<int> size; // Number of nodes of every column
+    std::vector<int> partial;
+
+    void cover(int col);
+    void uncover(int col);
+    int chooseColumn() const;
+    bool search(std::vector<int> &solution);
+    unsigned long long countFrom();
+};
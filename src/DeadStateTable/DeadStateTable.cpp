@@ -0,0 +1,162 @@
+#include "DeadStateTable.hpp"
+
+/**
+ * @brief Construct a new Dead State Table
+ *
+ * @param memory_budget Maximum size of the table in bytes, rounded down to a power of two buckets
+ * @param policy Which entry to drop when a bucket is full
+ */
+DeadStateTable::DeadStateTable(std::size_t memory_budget, ReplacementPolicy policy)
+    : policy(policy)
+{
+    std::size_t buckets = 1;
+    while (buckets * 2 * 2 * sizeof(Slot) <= memory_budget)
+    {
+        buckets *= 2;
+    }
+    bucket_mask = buckets - 1;
+    slots = std::vector<Slot>(buckets * 2);
+}
+
+/**
+ * @brief Read a slot, a slot written concurrently or holding another key is a miss
+ *
+ * @return true if the slot holds key
+ */
+bool DeadStateTable::read(const Slot &slot, uint64_t key, uint64_t &data) const
+{
+    data = slot.data.load(std::memory_order_relaxed);
+    uint64_t lock = slot.lock.load(std::memory_order_relaxed);
+    return (data & VALID_BIT) && (lock ^ data) == key;
+}
+
+void DeadStateTable::write(Slot &slot, uint64_t key, uint64_t data)
+{
+    slot.data.store(data, std::memory_order_relaxed);
+    slot.lock.store(key ^ data, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Know if a frontier is already known as dead
+ *
+ * @param key Hash of the frontier, select the bucket
+ * @param check Second independent hash of the frontier, reject key collisions
+ * @return true if the frontier has no solution
+ */
+bool DeadStateTable::contains(uint64_t key, uint64_t check)
+{
+    probes.fetch_add(1, std::memory_order_relaxed);
+    const Slot *bucket = &slots[(key & bucket_mask) * 2];
+    for (int i = 0; i < 2; i++)
+    {
+        uint64_t data;
+        if (read(bucket[i], key, data) && (data & CHECK_MASK) == (check & CHECK_MASK))
+        {
+            hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Record a dead frontier
+ *
+ * @param key Hash of the frontier
+ * @param check Second independent hash of the frontier
+ * @param depth Number of placed tiles, the lower the bigger the pruned subtree
+ */
+void DeadStateTable::insert(uint64_t key, uint64_t check, int depth)
+{
+    Slot *bucket = &slots[(key & bucket_mask) * 2];
+    uint64_t data = (check & CHECK_MASK) | VALID_BIT | (static_cast<uint64_t>(depth) & DEPTH_MASK);
+
+    uint64_t current[2], locks[2];
+    bool valid[2];
+    for (int i = 0; i < 2; i++)
+    {
+        current[i] = bucket[i].data.load(std::memory_order_relaxed);
+        locks[i] = bucket[i].lock.load(std::memory_order_relaxed);
+        valid[i] = current[i] & VALID_BIT;
+    }
+
+    int victim = -1;
+    if (!valid[0])
+        victim = 0;
+    else if (!valid[1])
+        victim = 1;
+    else if (policy == ReplacementPolicy::AlwaysReplace)
+        victim = 1;
+    else if (policy == ReplacementPolicy::DepthPreferred)
+    {
+        int deepest = (current[0] & DEPTH_MASK) >= (current[1] & DEPTH_MASK) ? 0 : 1;
+        if (static_cast<uint64_t>(depth) <= (current[deepest] & DEPTH_MASK))
+            victim = deepest;
+    }
+    else
+    {
+        // Demote the depth-preferred entry when the new one prunes more
+        if (static_cast<uint64_t>(depth) <= (current[0] & DEPTH_MASK))
+        {
+            write(bucket[1], locks[0] ^ current[0], current[0]);
+            victim = 0;
+        }
+        else
+            victim = 1;
+    }
+
+    if (victim < 0)
+        return;
+    if (valid[victim])
+        replacements.fetch_add(1, std::memory_order_relaxed);
+    stores.fetch_add(1, std::memory_order_relaxed);
+    write(bucket[victim], key, data);
+}
+
+/**
+ * @brief Forget every dead frontier and reset the statistics
+ */
+void DeadStateTable::clear()
+{
+    for (Slot &slot : slots)
+    {
+        slot.data.store(0, std::memory_order_relaxed);
+        slot.lock.store(0, std::memory_order_relaxed);
+    }
+    probes.store(0);
+    hits.store(0);
+    stores.store(0);
+    replacements.store(0);
+}
+
+/**
+ * @brief Ratio of probes answered by the table
+ *
+ * @return double between 0 and 1
+ */
+double DeadStateTable::hitRate() const
+{
+    uint64_t probed = getProbes();
+    return probed == 0 ? 0.0 : static_cast<double>(getHits()) / probed;
+}
+
+/**
+ * @brief Combine a value into a hash (splitmix64 finalizer)
+ */
+uint64_t mixHash(uint64_t hash, uint64_t value)
+{
+    uint64_t z = hash ^ (value + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2));
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Two independent hashes of a Tile, identical tiles share them
+ */
+void tileSignature(const Tile &tile, uint64_t &key, uint64_t &check)
+{
+    uint64_t colors = static_cast<uint8_t>(tile.left) | static_cast<uint8_t>(tile.top) << 8 | static_cast<uint8_t>(tile.right) << 16 | static_cast<uint64_t>(static_cast<uint8_t>(tile.bottom)) << 24;
+    key = mixHash(0x6A09E667F3BCC908ULL, colors);
+    check = mixHash(0xBB67AE8584CAA73BULL, colors);
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../Tile/Tile.hpp"
+
+enum class ReplacementPolicy
+{
+    AlwaysReplace,  // The newest entry always wins
+    DepthPreferred, // Keep the shallowest entries, they prune the biggest subtrees
+    TwoTier         // One depth-preferred slot and one always-replace slot per bucket
+};
+
+// Bounded hash table of frontier signatures known to have no solution.
+// Entries use the xor trick of lockless transposition tables : a torn write is
+// read as a miss, so one table can be shared by every solver thread without lock.
+class DeadStateTable
+{
+public:
+    DeadStateTable(std::size_t memory_budget = 64 << 20, ReplacementPolicy policy = ReplacementPolicy::TwoTier);
+
+    bool contains(uint64_t key, uint64_t check);
+    void insert(uint64_t key, uint64_t check, int depth);
+    void clear();
+
+    std::size_t capacity() const { return slots.size(); }
+    uint64_t getProbes() const { return probes.load(std::memory_order_relaxed); }
+    uint64_t getHits() const { return hits.load(std::memory_order_relaxed); }
+    uint64_t getStores() const { return stores.load(std::memory_order_relaxed); }
+    uint64_t getReplacements() const { return replacements.load(std::memory_order_relaxed); }
+    double hitRate() const;
+
+private:
+    struct Slot
+    {
+        std::atomic<uint64_t> lock{0}; // key ^ data
+        std::atomic<uint64_t> data{0}; // check bits | valid bit | depth
+    };
+
+    static constexpr uint64_t DEPTH_MASK = 0x7FFF;
+    static constexpr uint64_t VALID_BIT = 0x8000;
+    static constexpr uint64_t CHECK_MASK = ~static_cast<uint64_t>(0xFFFF);
+
+    ReplacementPolicy policy;
+    uint64_t bucket_mask;
+    std::vector<Slot> slots; // Buckets of two consecutive slots
+
+    std::atomic<uint64_t> probes{0};
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> stores{0};
+    std::atomic<uint64_t> replacements{0};
+
+    bool read(const Slot &slot, uint64_t key, uint64_t &data) const;
+    void write(Slot &slot, uint64_t key, uint64_t data);
+};
+
+// Hashes used to build the frontier signatures stored in the table
+uint64_t mixHash(uint64_t hash, uint64_t value);
+void tileSignature(const Tile &tile, uint64_t &key, uint64_t &check);
@@ -0,0 +1,90 @@
+#include <array>
+#include "Feasibility.hpp"
+
+namespace
+{
+    FeasibilityReport infeasible(FeasibilityStatus status, const std::string &reason)
+    {
+        FeasibilityReport report;
+        report.status = status;
+        report.reason = reason;
+        return report;
+    }
+
+    std::string colorName(char color)
+    {
+        return std::string("'") + color + "'";
+    }
+}
+
+/**
+ * @brief Check the tile count, the pairing of the inner edge colors and the frame color
+ *
+ * @param rows Board height
+ * @param cols Board width
+ * @param tiles Tiles of the puzzle
+ * @return FeasibilityReport the first failed condition, with a readable reason
+ */
+FeasibilityReport analyzeFeasibility(int rows, int cols, const std::vector<Tile> &tiles)
+{
+    const std::size_t cells = static_cast<std::size_t>(rows) * static_cast<std::size_t>(cols);
+    if (rows <= 0 || cols <= 0 || tiles.size() != cells)
+    {
+        return infeasible(FeasibilityStatus::TileCount, std::to_string(tiles.size()) + " tile(s) for a " + std::to_string(cols) + "x" +
+                                                            std::to_string(rows) + " board of " + std::to_string(cells) + " cell(s)");
+    }
+
+    std::array<int, 256> top{}, right{}, bottom{}, left{};
+    for (const Tile &tile : tiles)
+    {
+        top[static_cast<unsigned char>(tile.top)]++;
+        right[static_cast<unsigned char>(tile.right)]++;
+        bottom[static_cast<unsigned char>(tile.bottom)]++;
+        left[static_cast<unsigned char>(tile.left)]++;
+    }
+
+    // The frame takes as many left as right sides of its color, every inner edge one left and one right side
+    for (int color = 0; color < 256; color++)
+    {
+        if (left[color] != right[color])
+            return infeasible(FeasibilityStatus::UnpairedEdges, colorName(static_cast<char>(color)) + " is on " + std::to_string(left[color]) +
+                                                                    " left side(s) but " + std::to_string(right[color]) + " right side(s)");
+        if (top[color] != bottom[color])
+            return infeasible(FeasibilityStatus::UnpairedEdges, colorName(static_cast<char>(color)) + " is on " + std::to_string(top[color]) +
+                                                                    " top side(s) but " + std::to_string(bottom[color]) + " bottom side(s)");
+    }
+
+    FeasibilityReport best = infeasible(FeasibilityStatus::NoFrameColor, "no color is on enough tile sides to be the frame");
+    for (int color = 0; color < 256; color++)
+    {
+        if (top[color] < cols || bottom[color] < cols || left[color] < rows || right[color] < rows)
+            continue;
+
+        // A corner tile has two frame sides, on a single row or column it has three or four
+        const char frame = static_cast<char>(color);
+        const char *names[] = {"top-left", "top-right", "bottom-right", "bottom-left"};
+        const int cornerRows[] = {0, 0, rows - 1, rows - 1};
+        const int cornerCols[] = {0, cols - 1, cols - 1, 0};
+        int missing = -1;
+        for (int corner = 0; corner < 4 && missing < 0; corner++)
+        {
+            bool found = false;
+            for (const Tile &tile : tiles)
+            {
+                if ((cornerRows[corner] != 0 || tile.top == frame) && (cornerCols[corner] != 0 || tile.left == frame) &&
+                    (cornerRows[corner] != rows - 1 || tile.bottom == frame) && (cornerCols[corner] != cols - 1 || tile.right == frame))
+                {
+                    found = true;
+                    break;
+                }
+            }
+            if (!found)
+                missing = corner;
+        }
+        if (missing < 0)
+            return FeasibilityReport();
+        best = infeasible(FeasibilityStatus::MissingCorner, "no tile fits the " + std::string(names[missing]) + " corner of a " +
+                                                                colorName(frame) + " frame");
+    }
+    return best;
+}
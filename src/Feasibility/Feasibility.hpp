@@ -0,0 +1,24 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "../Tile/Tile.hpp"
+
+enum class FeasibilityStatus
+{
+    Feasible,      // Every necessary condition holds, the puzzle may still have no solution
+    TileCount,     // The number of tiles differs from the number of cells
+    NoFrameColor,  // No color is on enough tile sides to be the frame
+    MissingCorner, // A corner has no tile with two frame sides
+    UnpairedEdges  // A color is not on as many left as right (or top as bottom) sides
+};
+
+struct FeasibilityReport
+{
+    FeasibilityStatus status = FeasibilityStatus::Feasible;
+    std::string reason;
+    bool feasible() const { return status == FeasibilityStatus::Feasible; }
+};
+
+// Necessary conditions of a solution, checked by counting colors in O(tiles * colors).
+// An infeasible report is a proof that the puzzle has no solution.
+FeasibilityReport analyzeFeasibility(int rows, int cols, const std::vector<Tile> &tiles);
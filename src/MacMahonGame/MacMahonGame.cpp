@@ -1,148 +1,76 @@
 #include "MacMahonGame.hpp"
+#include <algorithm>
+#include <memory>
 #include <atomic> // Include for std::atomic
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <functional>
+#include <cstdlib>
 #include <unordered_map>
 #include <mutex>
 // #define DEBUG
 
-std::vector<char> MacMahonGame::convertToCharVector(const std::vector<std::string> &strVec)
-{
-    std::vector<char> charVec;
-
-    // Calculate total characters
-    size_t totalChars = 0;
-    for (const auto &str : strVec)
-    {
-        totalChars += str.size();
-    }
-    charVec.reserve(totalChars);
-
-    // Populate charVec using std::copy
-    for (const auto &str : strVec)
-    {
-        std::copy(str.begin(), str.end(), std::back_inserter(charVec));
-    }
-
-    return charVec;
-}
+/**
+ * @brief Construct a new MacMahon Game from a puzzle file
+ *
+ * @param filename Puzzle file, parsed by Puzzle
+ */
+MacMahonGame::MacMahonGame(const std::string &filename) : MacMahonGame(Puzzle(filename)) {}
 
-MacMahonGame::MacMahonGame(const std::string &filename)
+/**
+ * @brief Construct a new MacMahon Game from an already parsed puzzle
+ *
+ * @param puzzle Copied, the game owns its tiles so they can be edited
+ */
+MacMahonGame::MacMahonGame(const Puzzle &puzzle)
+    : rows(puzzle.getRows()), cols(puzzle.getCols()), max_depth(puzzle.getRows() * puzzle.getCols()),
+      grid(puzzle.getTiles()), tile_types(puzzle.getTileTypes())
 {
     solution_found_threadpool.store(false);
     solution_found_parallel_recursion.store(false);
-    std::ifstream file(filename);
-    std::string line;
-    if (!std::getline(file, line))
-    {
-        throw std::runtime_error("❌ \033[1;31m Error :\033[0m Failed to read the header from the file: " + filename + " ❌");
-    }
-
-    std::vector<std::string> vectLine = split(line, ' ');
-    if (vectLine.size() != 2)
-    {
-        throw std::runtime_error("❌ \033[1;31m Error :\033[0mUnexpected header format in the file: " + filename + " ❌");
-    }
-
-    this->grid = std::vector<Tile>();
-    this->cols = std::stoi(vectLine[0]);
-    this->rows = std::stoi(vectLine[1]);
-    max_depth = cols * rows;
-    for (int i = 0; i < rows; i++)
-    {
-        std::vector<Tile> row;
-        for (int j = 0; j < cols; j++)
-        {
-            row.emplace_back(Tile(' ', ' ', ' ', ' '));
-        }
-        this->result.emplace_back(row);
-    }
-
-    int lineNum = 2;
-    while (std::getline(file, line))
+    result.assign(rows, std::vector<Tile>(cols, Tile(' ', ' ', ' ', ' ')));
+    for (size_t type = 0; type < tile_types.size(); type++)
     {
-        std::vector<std::string> vectLine = split(line, ' ');
-        if (vectLine.size() != 4)
-        {
-            throw std::runtime_error("❌ \033[1;31m Error :\033[0mUnexpected line format at " + std::to_string(lineNum) + "\nPlease check the file: " + filename + " ❌");
-        }
-        std::vector<char> tileColors = convertToCharVector(vectLine);
-        this->grid.emplace_back(Tile(tileColors[0], tileColors[1], tileColors[2], tileColors[3]));
-        lineNum++;
+        type_keys.push_back(puzzle.getTypeKey(static_cast<int>(type)));
+        type_checks.push_back(puzzle.getTypeCheck(static_cast<int>(type)));
     }
 }
 
 /**
- * @brief Optimize split of string
+ * @brief Reject the puzzles that cannot have a solution without searching
  *
- * @param s String to split
- * @param delimiter Char who delimits the string
- * @return std::string
- * @author Aubertin Emmanuel
+ * @return FeasibilityReport
  */
-std::vector<std::string> MacMahonGame::split(const std::string &s, char delimiter)
+FeasibilityReport MacMahonGame::checkFeasibility() const
 {
-    std::vector<std::string> tokens;
-    tokens.reserve(s.size() / 5);
-
-    std::istringstream tokenStream(s);
-    std::string token;
-
-    while (std::getline(tokenStream, token, delimiter))
-    {
-        tokens.emplace_back(std::move(token));
-    }
-    return tokens;
+    return analyzeFeasibility(rows, cols, grid);
 }
 
 /**
- * @brief Get colors of a part of the Tile
+ * @brief First step of every solver, before its search touches anything
  *
- * @param c
- * @return std::string
- * @author Aubertin Emmanuel
+ * @return true if the puzzle passes the feasibility analysis and the search may start
  */
-std::string MacMahonGame::getColorCode(char c)
+bool MacMahonGame::isFeasible() const
 {
-    static std::unordered_map<char, std::string> colorMap = {
-        {'R', "\033[41m"}, // Red background
-        {'G', "\033[42m"}, // Green background
-        {'B', "\033[44m"}, // Blue background
-    };
-
-    auto it = colorMap.find(c);
-    if (it != colorMap.end())
-    {
-        return it->second;
-    }
-    else
-    {
-        return "\033[0m"; // Default (reset color)
-    }
+    return checkFeasibility().feasible();
 }
 
 /**
- * @brief Convert 2D vector to 1D vector
- *
- * @param matrix 2D vector to flatten
- * @return std::vector<Tile>
- * @author Aubertin Emmanuel
+ * @brief Give back every copy and empty the board, so every solver starts from scratch
+ * and a game can be solved again
  */
-std::vector<Tile> MacMahonGame::flatten(const std::vector<std::vector<Tile>> &matrix)
+void MacMahonGame::resetSolveState()
 {
-    std::vector<Tile> result;
-
-    // Flatten the matrix into the result vector
-    for (const auto &row : matrix)
+    for (TileType &type : tile_types)
     {
-        for (const auto &col : row)
-        {
-            result.push_back(col);
-        }
+        type.remaining = type.count;
+    }
+    for (std::vector<Tile> &row : result)
+    {
+        std::fill(row.begin(), row.end(), Tile(' ', ' ', ' ', ' '));
     }
-
-    return result;
 }
 
 /**
@@ -150,90 +78,21 @@ std::vector<Tile> MacMahonGame::flatten(const std::vector<std::vector<Tile>> &ma
  *
  * @author Aubertin Emmanuel
  */
-void MacMahonGame::print() { print(grid); }
+void MacMahonGame::print() { renderer.print(rows, cols, grid); }
 
 /**
  * @brief Print result vector Tiles
  *
  * @author Aubertin Emmanuel
  */
-void MacMahonGame::printResult() { print(flatten(result)); }
+void MacMahonGame::printResult() { renderer.print(rows, cols, result); }
 
 /**
- * @brief Print a grid
+ * @brief Choose how print and printResult draw the tiles
  *
- * @author Aubertin Emmanuel
+ * @param mode Colors, plain letters or the input file format
  */
-void MacMahonGame::print(std::vector<Tile> inGrid)
-{
-    const int rows_dips = 5;
-    for (int row = 0; row < rows; ++row)
-    {
-
-        // Top half including middle line
-        for (int i = 1; i <= rows_dips; ++i)
-        {
-            // Print left top
-            for (int index = rows * row; index < rows * row + this->cols; ++index)
-            {
-                for (int j = 1; j <= i; ++j)
-                {
-                    std::cout << getColorCode(inGrid[index].left) << "  "
-                              << "\033[0m";
-                }
-
-                // Print top top
-                for (int j = 1; j <= rows_dips - i; ++j)
-                {
-                    std::cout << getColorCode(inGrid[index].top) << "    "
-                              << "\033[0m";
-                }
-
-                // Print right top
-                for (int j = 1; j <= i; ++j)
-                {
-                    std::cout << getColorCode(inGrid[index].right) << "  "
-                              << "\033[0m";
-                }
-
-                std::cout << " ";
-            }
-
-            std::cout << std::endl;
-        }
-
-        // Bottom half excluding middle line
-        for (int i = rows_dips - 1; i >= 1; --i)
-        {
-            for (int index = rows * row; index < rows * row + this->cols; ++index)
-            {
-                // Print bottom left
-                for (int j = 1; j <= i; ++j)
-                {
-                    std::cout << getColorCode(inGrid[index].left) << "  "
-                              << "\033[0m";
-                }
-
-                // Print bottom bottom
-                for (int j = 1; j <= rows_dips - i; ++j)
-                {
-                    std::cout << getColorCode(inGrid[index].bottom) << "    "
-                              << "\033[0m";
-                }
-
-                // Print bottom right
-                for (int j = 1; j <= i; ++j)
-                {
-                    std::cout << getColorCode(inGrid[index].right) << "  "
-                              << "\033[0m";
-                }
-                std::cout << " ";
-            }
-            std::cout << std::endl;
-        }
-        std::cout << std::endl;
-    }
-}
+void MacMahonGame::setRenderMode(RenderMode mode) { renderer.setMode(mode); }
 
 /**
  * @brief Check if you place a Tile
@@ -263,8 +122,8 @@ bool MacMahonGame::isSafe(int row, int col, const Tile &tile)
  */
 bool MacMahonGame::isSafe(int row, int col, const Tile &tile, const std::vector<std::vector<Tile>> &board)
 {
-    // If the top-left tile is used, it will be our reference
-    if (board[0][0].used)
+    // If the top-left tile is used, it will be our reference (but not when re-filling the top-left cell itself)
+    if (board[0][0].used && (row != 0 || col != 0))
     {
         if (row == 0 && tile.top != board[0][0].top)
             return false;
@@ -285,7 +144,7 @@ bool MacMahonGame::isSafe(int row, int col, const Tile &tile, const std::vector<
             return false;
     }
 
-    if (!board[0][0].used && row == 0 && col == 0 && tile.top != tile.left)
+    if (row == 0 && col == 0 && tile.top != tile.left)
     {
         return false;
     }
@@ -320,6 +179,11 @@ bool MacMahonGame::isBorderCorrect()
 
 bool MacMahonGame::solve()
 {
+    resetSolveState();
+    last_exhaustive = true;
+    if (!isFeasible())
+        return false;
+    remainingSignature(remainingCounts(), remaining_key, remaining_check);
     return solve(0, 0);
 }
 
@@ -336,22 +200,191 @@ bool MacMahonGame::solve(int row, int col)
 {
     if (row == rows)
         return true;
+    uint64_t key = 0, check = 0;
+    bool memoized = false;
+    if (probeDeadState(row, col, memoized, key, check))
+        return false;
     int nextRow = (col == cols - 1) ? row + 1 : row;
     int nextCol = (col == cols - 1) ? 0 : col + 1;
-    for (Tile &tile : grid)
+    for (int type = 0; type < static_cast<int>(tile_types.size()); type++)
     {
-        if (!tile.used && isSafe(row, col, tile))
+        if (tile_types[type].remaining > 0 && isSafe(row, col, tile_types[type].tile))
         {
-            tile.used = true;
-            this->result[row][col] = tile;
+            takeTile(type);
+            this->result[row][col] = tile_types[type].tile;
             if (solve(nextRow, nextCol))
                 return true;
-            tile.used = false;
+            putBackTile(type);
         }
     }
+    if (memoized)
+        dead_states->insert(key, check, row * cols + col);
     return false;
 }
 
+/**
+ * @brief Re-solve after editing the tile set, starting from the previous solution.
+ *
+ * Tiles of the previous solution still in the tile set stay in place, the other cells are holes.
+ * The holes and their neighbourhood are searched with a node budget, the neighbourhood grows
+ * until the whole board is free, then the full backtracking search runs. The dead state table
+ * stays valid across edits : its subproblems only depend on the tiles they hold. An infeasible
+ * tile set fails without a search and keeps the previous board for the next edit.
+ *
+ * @param repair_nodes Node budget of every local repair
+ * @return true if there is a solution
+ */
+bool MacMahonGame::solve_incremental(uint64_t repair_nodes)
+{
+    last_nodes = 0;
+    last_repair_radius = -1;
+    last_exhaustive = true;
+    // Before the board is touched : the previous solution stays the warm start of the next edit
+    if (!isFeasible())
+        return false;
+    for (TileType &type : tile_types)
+    {
+        type.remaining = type.count;
+    }
+
+    if (isBoardSolved())
+    {
+        std::vector<int> kept(rows * cols, -1);
+        std::vector<int> holes;
+        for (int cell = 0; cell < rows * cols; cell++)
+        {
+            int type = findTileType(result[cell / cols][cell % cols]);
+            if (type >= 0 && tile_types[type].remaining > 0)
+            {
+                kept[cell] = type;
+                tile_types[type].remaining--;
+            }
+            else
+            {
+                holes.push_back(cell);
+            }
+        }
+        for (TileType &type : tile_types)
+        {
+            type.remaining = type.count;
+        }
+
+        for (int radius = 0; radius < std::max(rows, cols); radius++)
+        {
+            SearchConfig config;
+            config.name = "repair";
+            config.node_limit = repair_nodes;
+            SearchEngine engine(rows, cols, tile_types, config);
+            int fixedCells = 0;
+            for (int cell = 0; cell < rows * cols; cell++)
+            {
+                bool nearHole = std::any_of(holes.begin(), holes.end(), [&](int hole)
+                                            { return std::abs(hole / cols - cell / cols) <= radius && std::abs(hole % cols - cell % cols) <= radius; });
+                if (kept[cell] >= 0 && !nearHole)
+                {
+                    engine.fixCell(cell, kept[cell]);
+                    fixedCells++;
+                }
+            }
+            // Nothing is left to keep, the full search is cheaper
+            if (fixedCells == 0)
+                break;
+            SearchStatus status = engine.run();
+            last_nodes += engine.getNodes();
+            if (status == SearchStatus::Solved)
+            {
+                result = engine.getResult();
+                last_repair_radius = radius;
+                return true;
+            }
+        }
+    }
+
+    return solve();
+}
+
+/**
+ * @brief Check that result holds a complete board with matching edges and frame,
+ * whatever the current tile set
+ *
+ * @return true if every cell is filled and every edge matches
+ */
+bool MacMahonGame::isBoardSolved()
+{
+    for (int row = 0; row < rows; row++)
+    {
+        for (int col = 0; col < cols; col++)
+        {
+            const Tile &tile = result[row][col];
+            if (!tile.used)
+                return false;
+            if (row > 0 && result[row - 1][col].bottom != tile.top)
+                return false;
+            if (col > 0 && result[row][col - 1].right != tile.left)
+                return false;
+        }
+    }
+    return isBorderCorrect();
+}
+
+/**
+ * @brief Count every solution of the puzzle
+ *
+ * @param expand Count interchangeable copies of a tile as different solutions
+ * @return unsigned long long
+ */
+unsigned long long MacMahonGame::count_solutions(bool expand)
+{
+    resetSolveState();
+    if (!isFeasible())
+        return 0;
+    remainingSignature(remainingCounts(), remaining_key, remaining_check);
+    return countSolutions(0, 0, expand);
+}
+
+/**
+ * @brief Backtraking counter, same walk as solve(row, col) without stopping at the first solution
+ *
+ * @param row index to solve
+ * @param col index to solve
+ * @param expand Count interchangeable copies of a tile as different solutions
+ * @return unsigned long long
+ */
+unsigned long long MacMahonGame::countSolutions(int row, int col, bool expand)
+{
+    if (row == rows)
+    {
+        // Every way to pick the used copies among the identical tiles gives another solution
+        unsigned long long multiplicity = 1;
+        for (const TileType &type : tile_types)
+        {
+            for (int copy = type.count; expand && copy > type.remaining; copy--)
+                multiplicity *= copy;
+        }
+        return multiplicity;
+    }
+    uint64_t key = 0, check = 0;
+    bool memoized = false;
+    if (probeDeadState(row, col, memoized, key, check))
+        return 0;
+    int nextRow = (col == cols - 1) ? row + 1 : row;
+    int nextCol = (col == cols - 1) ? 0 : col + 1;
+    unsigned long long count = 0;
+    for (int type = 0; type < static_cast<int>(tile_types.size()); type++)
+    {
+        if (tile_types[type].remaining > 0 && isSafe(row, col, tile_types[type].tile))
+        {
+            takeTile(type);
+            this->result[row][col] = tile_types[type].tile;
+            count += countSolutions(nextRow, nextCol, expand);
+            putBackTile(type);
+        }
+    }
+    if (memoized && count == 0)
+        dead_states->insert(key, check, row * cols + col);
+    return count;
+}
+
 /**
  * @brief Multithreading Solver using ThreadPool
  *
@@ -360,27 +393,31 @@ bool MacMahonGame::solve(int row, int col)
  */
 bool MacMahonGame::solve_thread()
 {
-
+    resetSolveState();
+    last_exhaustive = true;
+    if (!isFeasible())
+        return false;
+    solution_found_threadpool.store(false);
     std::mutex solution_mutex;
     ThreadPool pool(std::thread::hardware_concurrency());
 
-    for (Tile &startingTile : grid)
+    for (int type = 0; type < static_cast<int>(tile_types.size()); type++)
     {
-        if (!startingTile.used && isSafe(0, 0, startingTile))
+        if (isSafe(0, 0, tile_types[type].tile))
         {
-            pool.addJob([&startingTile, this, &solution_mutex, &pool]()
+            pool.addJob([type, this, &solution_mutex]()
                         {
-            std::lock_guard<std::mutex> lock(solution_mutex); 
-            
-                startingTile.used = true;
-                this->result[0][0] = startingTile;
-                if (solve(0, 1)) {
-                    solution_found_threadpool.store(true);
+                // Every job searches its own board, the first cell holding its tile type,
+                // and stops as soon as another job found a solution
+                SearchConfig config;
+                config.name = "threadpool";
+                SearchEngine engine(rows, cols, tile_types, config, &solution_found_threadpool, dead_states);
+                engine.fixCell(0, type);
+                if (engine.run() != SearchStatus::Solved)
                     return;
-                }
-                startingTile.used = false;
-            
-            return; });
+                std::lock_guard<std::mutex> lock(solution_mutex);
+                if (!solution_found_threadpool.exchange(true))
+                    result = engine.getResult(); });
         }
     }
     pool.start();
@@ -389,108 +426,1101 @@ bool MacMahonGame::solve_thread()
     return solution_found_threadpool.load();
 }
 
+/**
+ * @brief Portfolio solver racing the default configurations, one per hardware thread (two at least)
+ *
+ * @param winner Set to the name of the configuration which answered first
+ * @return true if there is a solution
+ */
+bool MacMahonGame::solve_portfolio(std::string &winner)
+{
+    return solve_portfolio(defaultPortfolio(std::max(2u, std::thread::hardware_concurrency())), winner);
+}
 
 /**
- * @brief Parrallel recursion
+ * @brief Portfolio solver : run one SearchEngine per configuration concurrently,
+ * the first one to find a solution or to prove there is none stops the others
  *
+ * @param configs Configurations to race
+ * @param winner Set to the name of the configuration which answered first, empty if none did,
+ * "feasibility" if the analysis rejected the puzzle
  * @return true if there is a solution
- * @author Aubertin Emmanuel
  */
-bool MacMahonGame::solve_parallel()
+bool MacMahonGame::solve_portfolio(const std::vector<SearchConfig> &configs, std::string &winner)
 {
-    tasks.push(Task(0, 0, result, grid));
-    std::vector<std::thread> threads;
-    for (int i = 0; i < std::thread::hardware_concurrency(); i++)
+    last_exhaustive = true;
+    if (!isFeasible())
     {
-        threads.emplace_back(&MacMahonGame::parallelRecursionThreadEngine, this);
+        winner = "feasibility";
+        return false;
     }
+    std::atomic<bool> cancel(false);
+    std::mutex winner_mutex;
+    int winnerIndex = -1;
+    bool solved = false;
 
-    // Wait for threads to complete
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < configs.size(); i++)
+    {
+        threads.emplace_back([&, i]()
+                             {
+            SearchEngine engine(rows, cols, tile_types, configs[i], &cancel, dead_states);
+            SearchStatus status = engine.run();
+            if (status != SearchStatus::Solved && status != SearchStatus::Exhausted)
+                return;
+            std::lock_guard<std::mutex> lock(winner_mutex);
+            if (winnerIndex >= 0)
+                return;
+            winnerIndex = static_cast<int>(i);
+            solved = status == SearchStatus::Solved;
+            if (solved)
+                result = engine.getResult();
+            cancel.store(true); });
+    }
     for (auto &thread : threads)
     {
         thread.join();
     }
 
-    return solution_found_parallel_recursion.load();
+    winner = winnerIndex >= 0 ? configs[winnerIndex].name : "";
+    // Every configuration stopped on its budget, nothing was proven
+    last_exhaustive = winnerIndex >= 0;
+    return solved;
 }
 
 /**
- * @brief Parrallel recursion
+ * @brief Randomized restarts : search with a seeded tile order and a node budget, then
+ * restart with a new order and a bigger budget. The same seed always gives the same run.
  *
- * @param max_depth Specification of a depth
+ * @param seed Seed of the tile orders
+ * @param schedule Luby or geometric (x2) node budgets
+ * @param base_nodes Node budget unit
+ * @param keep_nogoods Keep the dead subproblems found by a restart for the next ones,
+ * in the table given to setDeadStateTable or else in a table local to the call
  * @return true if there is a solution
- * @author Aubertin Emmanuel
  */
-bool MacMahonGame::solve_parallel(const int &max_depth)
+bool MacMahonGame::solve_restart(uint64_t seed, RestartSchedule schedule, uint64_t base_nodes, bool keep_nogoods)
 {
-    this->max_depth = max_depth;
-    return solve_parallel();
+    SearchConfig config;
+    config.name = "restart";
+    config.value_order = ValueOrder::Shuffled;
+    config.seed = seed;
+    config.node_limit = base_nodes;
+    config.restart_schedule = schedule;
+    last_restarts = 0;
+    last_nodes = 0;
+    last_exhaustive = true;
+    if (!isFeasible())
+        return false;
+
+    std::unique_ptr<DeadStateTable> localNogoods;
+    DeadStateTable *nogoods = nullptr;
+    if (keep_nogoods)
+    {
+        if (!dead_states)
+            localNogoods = std::make_unique<DeadStateTable>(16 << 20);
+        nogoods = dead_states ? dead_states : localNogoods.get();
+    }
+
+    SearchEngine engine(rows, cols, tile_types, config, nullptr, nogoods);
+    SearchStatus status = engine.run();
+    last_restarts = engine.getRestarts();
+    last_nodes = engine.getNodes();
+    last_exhaustive = status == SearchStatus::Solved || status == SearchStatus::Exhausted;
+    if (status != SearchStatus::Solved)
+        return false;
+    result = engine.getResult();
+    return true;
 }
 
 /**
- * @brief Parrallel recursion
+ * @brief Queue the puzzle on a cooperative scheduler shared with other puzzles
  *
- * @param inTask Current task to compute
- * @param depth Current recurition depth
- * @author Aubertin Emmanuel
+ * @param priority Higher runs first
+ * @param deadline The search is cancelled once it passes
+ * @return std::size_t id of the result in the scheduler
  */
-void MacMahonGame::parallelRecursion(Task inTask, int depth)
+std::size_t MacMahonGame::schedule(PuzzleScheduler &scheduler, int priority, PuzzleScheduler::Clock::time_point deadline)
 {
+    return scheduler.submit(rows, cols, tile_types, priority, deadline);
+}
 
-    if (solution_found_parallel_recursion.load())
+/**
+ * @brief Take the board of a finished scheduled search
+ *
+ * @param scheduled Result of the id returned by schedule, after PuzzleScheduler::wait
+ * @return true if there is a solution
+ */
+bool MacMahonGame::collect(const ScheduledResult &scheduled)
+{
+    last_nodes = scheduled.nodes;
+    if (scheduled.status != SearchStatus::Solved)
+        return false;
+    result = scheduled.board;
+    return true;
+}
+
+/**
+ * @brief Exact cover solver (Dancing Links), one matrix per frame color
+ *
+ * @return true if there is a solution
+ */
+bool MacMahonGame::solve_dlx()
+{
+    last_exhaustive = true;
+    if (!isFeasible())
+        return false;
+    for (char frame : colors())
     {
-        return;
+        std::vector<std::pair<int, int>> placements;
+        std::unique_ptr<DancingLinks> cover = exactCover(frame, placements);
+        std::vector<int> solution;
+        if (!cover || !cover->solve(solution))
+            continue;
+        for (int placement : solution)
+        {
+            auto [cell, type] = placements[placement];
+            result[cell / cols][cell % cols] = tile_types[type].tile;
+        }
+        return true;
     }
+    return false;
+}
 
-    if (inTask.row == rows)
+/**
+ * @brief Count every solution with the exact cover solver
+ *
+ * @param expand Count interchangeable copies of a tile as different solutions
+ * @return unsigned long long
+ */
+unsigned long long MacMahonGame::count_dlx(bool expand)
+{
+    if (!isFeasible())
+        return 0;
+    unsigned long long count = 0;
+    for (char frame : colors())
     {
-        result = inTask.result;
-        solution_found_parallel_recursion.store(true);
-        return;
+        std::vector<std::pair<int, int>> placements;
+        std::unique_ptr<DancingLinks> cover = exactCover(frame, placements);
+        if (cover)
+            count += cover->count();
     }
+    return expand ? count * multiplicity() : count;
+}
 
-    int nextRow = (inTask.col == cols - 1) ? inTask.row + 1 : inTask.row;
-    int nextCol = (inTask.col == cols - 1) ? 0 : inTask.col + 1;
+/**
+ * @brief Index of a color in the sorted palette returned by colors()
+ *
+ * @param palette Sorted colors
+ * @param color Color of the palette
+ * @return int
+ */
+int MacMahonGame::colorIndex(const std::vector<char> &palette, char color)
+{
+    return static_cast<int>(std::lower_bound(palette.begin(), palette.end(), color) - palette.begin());
+}
 
-    for (Tile &tile : inTask.grid)
+/**
+ * @brief Every color used by a tile, sorted
+ *
+ * @return std::vector<char>
+ */
+std::vector<char> MacMahonGame::colors()
+{
+    std::vector<char> palette;
+    for (const TileType &type : tile_types)
     {
-        if (!tile.used && isSafe(inTask.row, inTask.col, tile, inTask.result))
+        for (char color : {type.tile.top, type.tile.right, type.tile.bottom, type.tile.left})
         {
-            tile.used = true;
-            inTask.result[inTask.row][inTask.col] = tile;
-            if (depth < max_depth)
-            {
-                std::lock_guard<std::mutex> lock(taskMutex);
-                tasks.push(Task(nextRow, nextCol, inTask.result, inTask.grid));
-                tile.used = false;
-                continue;
-            }
-            parallelRecursion(Task(nextRow, nextCol, inTask.result, inTask.grid), depth + 1);
-            if (!solution_found_parallel_recursion.load())
-                tile.used = false;
+            if (std::find(palette.begin(), palette.end(), color) == palette.end())
+                palette.push_back(color);
         }
     }
-    result = inTask.result;
+    std::sort(palette.begin(), palette.end());
+    return palette;
 }
 
 /**
- * @brief Running Task in thread
+ * @brief Check the sides of a tile lying on the frame
  *
- * @author Aubertin Emmanuel
+ * @return true if every frame side of the tile has the frame color
  */
-void MacMahonGame::parallelRecursionThreadEngine()
+bool MacMahonGame::fitsFrame(int row, int col, const Tile &tile, char frame)
 {
-    while (!solution_found_parallel_recursion.load())
-    {
-        Task currentTask;
-        {
-            std::lock_guard<std::mutex> lock(taskMutex);
-            if (tasks.empty())
-                return;
+    return (row != 0 || tile.top == frame) && (col != 0 || tile.left == frame) &&
+           (row != rows - 1 || tile.bottom == frame) && (col != cols - 1 || tile.right == frame);
+}
+
+/**
+ * @brief Exact cover matrix of the puzzle for one frame color.
+ *
+ * Primary columns : every cell, every tile copy. Secondary columns : (edge, color) pairs, a tile
+ * takes the color of its side on one end of an edge and every other color on the other end, so two
+ * placements conflict when the colors differ. Copies of a tile type must fill increasing cells
+ * (chain of secondary columns), so interchangeable copies do not multiply the solutions.
+ *
+ * @param frame Frame color
+ * @param placements Set to the (cell, tile type) of every matrix row
+ * @return std::unique_ptr<DancingLinks> nullptr when the tiles cannot fill the board exactly
+ */
+std::unique_ptr<DancingLinks> MacMahonGame::exactCover(char frame, std::vector<std::pair<int, int>> &placements)
+{
+    const int cells = rows * cols;
+    if (grid.size() != static_cast<size_t>(cells))
+        return nullptr;
+
+    std::vector<char> palette = colors();
+    const int colorCount = static_cast<int>(palette.size());
+    std::vector<int> firstCopy, firstChain;
+    int copies = 0, chains = 0;
+    for (const TileType &type : tile_types)
+    {
+        firstCopy.push_back(copies);
+        firstChain.push_back(chains);
+        copies += type.count;
+        chains += type.count - 1;
+    }
+
+    const int horizontal = cells + copies;
+    const int vertical = horizontal + rows * (cols - 1) * colorCount;
+    const int chain = vertical + (rows - 1) * cols * colorCount;
+    const int secondary = chain + chains * cells - horizontal;
+    std::unique_ptr<DancingLinks> cover = std::make_unique<DancingLinks>(cells + copies, secondary);
+
+    placements.clear();
+    std::vector<int> columns;
+    for (int cell = 0; cell < cells; cell++)
+    {
+        int row = cell / cols, col = cell % cols;
+        for (int type = 0; type < static_cast<int>(tile_types.size()); type++)
+        {
+            const Tile &tile = tile_types[type].tile;
+            if (!fitsFrame(row, col, tile, frame))
+                continue;
+            for (int copy = 0; copy < tile_types[type].count; copy++)
+            {
+                columns.clear();
+                columns.push_back(cell);
+                columns.push_back(cells + firstCopy[type] + copy);
+                for (int color = 0; color < colorCount; color++)
+                {
+                    if (col < cols - 1 && color != colorIndex(palette, tile.right))
+                        columns.push_back(horizontal + (row * (cols - 1) + col) * colorCount + color);
+                    if (row < rows - 1 && color != colorIndex(palette, tile.bottom))
+                        columns.push_back(vertical + (row * cols + col) * colorCount + color);
+                }
+                if (col > 0)
+                    columns.push_back(horizontal + (row * (cols - 1) + col - 1) * colorCount + colorIndex(palette, tile.left));
+                if (row > 0)
+                    columns.push_back(vertical + ((row - 1) * cols + col) * colorCount + colorIndex(palette, tile.top));
+                if (copy > 0)
+                    columns.push_back(chain + (firstChain[type] + copy - 1) * cells + cell);
+                for (int before = 0; copy < tile_types[type].count - 1 && before <= cell; before++)
+                    columns.push_back(chain + (firstChain[type] + copy) * cells + before);
+
+                cover->addRow(columns, static_cast<int>(placements.size()));
+                placements.emplace_back(cell, type);
+            }
+        }
+    }
+    return cover;
+}
+
+/**
+ * @brief SAT solver on the CNF encoding of the puzzle
+ *
+ * @return true if there is a solution
+ */
+bool MacMahonGame::solve_sat()
+{
+    last_exhaustive = true;
+    if (!isFeasible())
+        return false;
+    SatSolver solver;
+    std::vector<std::vector<int>> placed = satEncoding(solver);
+    if (!solver.solve())
+        return false;
+    for (int cell = 0; cell < rows * cols; cell++)
+    {
+        for (int type = 0; type < static_cast<int>(tile_types.size()); type++)
+        {
+            if (placed[cell][type] != 0 && solver.value(placed[cell][type]))
+                result[cell / cols][cell % cols] = tile_types[type].tile;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Write the CNF encoding of the puzzle in the DIMACS format, for external SAT solvers
+ *
+ * @param path Output file
+ * @return true if the file was written
+ */
+bool MacMahonGame::export_cnf(const std::string &path)
+{
+    SatSolver solver;
+    satEncoding(solver);
+    std::ofstream file(path, std::ios::trunc);
+    if (!file)
+        return false;
+    file << "c MacMahon " << cols << "x" << rows << ", variable (cell * types + type + 1) places a tile type on a cell\n";
+    solver.writeDimacs(file);
+    return static_cast<bool>(file);
+}
+
+/**
+ * @brief CNF encoding of the puzzle.
+ *
+ * Variables : tile type on a cell (only when its frame sides share one color), frame color, color
+ * of every inner edge. Clauses : exactly one type per cell, at most count copies of a type
+ * (sequential counter), exactly one frame color, at most one color per edge, and every placed tile
+ * sets the color of its edges and of the frame.
+ *
+ * @param solver Receives the variables and clauses
+ * @return std::vector<std::vector<int>> variable of every (cell, tile type), 0 when impossible
+ */
+std::vector<std::vector<int>> MacMahonGame::satEncoding(SatSolver &solver)
+{
+    const int cells = rows * cols;
+    const int typeCount = static_cast<int>(tile_types.size());
+    std::vector<char> palette = colors();
+    const int colorCount = static_cast<int>(palette.size());
+    // Placement variables are created first so their number is cell * types + type + 1
+    std::vector<std::vector<int>> placed(cells, std::vector<int>(typeCount, 0));
+    std::vector<std::vector<int>> frameSides(cells, std::vector<int>(typeCount, -1));
+    for (int cell = 0; cell < cells; cell++)
+    {
+        int row = cell / cols, col = cell % cols;
+        for (int type = 0; type < typeCount; type++)
+        {
+            int variable = solver.newVariable();
+            const Tile &tile = tile_types[type].tile;
+            std::vector<char> sides;
+            if (row == 0)
+                sides.push_back(tile.top);
+            if (col == 0)
+                sides.push_back(tile.left);
+            if (row == rows - 1)
+                sides.push_back(tile.bottom);
+            if (col == cols - 1)
+                sides.push_back(tile.right);
+            if (std::adjacent_find(sides.begin(), sides.end(), std::not_equal_to<char>()) != sides.end())
+            {
+                solver.addClause({-variable});
+                continue;
+            }
+            placed[cell][type] = variable;
+            if (!sides.empty())
+                frameSides[cell][type] = colorIndex(palette, sides[0]);
+        }
+    }
+    if (grid.size() != static_cast<size_t>(cells))
+    {
+        solver.addClause({});
+        return placed;
+    }
+
+    auto atMostOne = [&solver](const std::vector<int> &variables)
+    {
+        for (size_t i = 0; i < variables.size(); i++)
+            for (size_t j = i + 1; j < variables.size(); j++)
+                solver.addClause({-variables[i], -variables[j]});
+    };
+
+    std::vector<int> frame;
+    for (int color = 0; color < colorCount; color++)
+        frame.push_back(solver.newVariable());
+    solver.addClause(frame);
+    atMostOne(frame);
+
+    // Horizontal edges first, then vertical edges
+    const int horizontalEdges = rows * (cols - 1);
+    std::vector<std::vector<int>> edges(horizontalEdges + (rows - 1) * cols);
+    for (std::vector<int> &edge : edges)
+    {
+        for (int color = 0; color < colorCount; color++)
+            edge.push_back(solver.newVariable());
+        atMostOne(edge);
+    }
+
+    for (int cell = 0; cell < cells; cell++)
+    {
+        int row = cell / cols, col = cell % cols;
+        std::vector<int> choices;
+        for (int type = 0; type < typeCount; type++)
+        {
+            int variable = placed[cell][type];
+            if (variable == 0)
+                continue;
+            choices.push_back(variable);
+            const Tile &tile = tile_types[type].tile;
+            if (frameSides[cell][type] >= 0)
+                solver.addClause({-variable, frame[frameSides[cell][type]]});
+            if (col < cols - 1)
+                solver.addClause({-variable, edges[row * (cols - 1) + col][colorIndex(palette, tile.right)]});
+            if (col > 0)
+                solver.addClause({-variable, edges[row * (cols - 1) + col - 1][colorIndex(palette, tile.left)]});
+            if (row < rows - 1)
+                solver.addClause({-variable, edges[horizontalEdges + row * cols + col][colorIndex(palette, tile.bottom)]});
+            if (row > 0)
+                solver.addClause({-variable, edges[horizontalEdges + (row - 1) * cols + col][colorIndex(palette, tile.top)]});
+        }
+        solver.addClause(choices);
+        atMostOne(choices);
+    }
+
+    // Sequential counter : counter[i][j] is true when at least j + 1 of the first i + 1 cells hold the type
+    for (int type = 0; type < typeCount; type++)
+    {
+        std::vector<int> cellsOfType;
+        for (int cell = 0; cell < cells; cell++)
+        {
+            if (placed[cell][type] != 0)
+                cellsOfType.push_back(placed[cell][type]);
+        }
+        const int limit = tile_types[type].count;
+        const int n = static_cast<int>(cellsOfType.size());
+        if (n <= limit)
+            continue;
+        std::vector<std::vector<int>> counter(n - 1, std::vector<int>(limit));
+        for (std::vector<int> &line : counter)
+            for (int &variable : line)
+                variable = solver.newVariable();
+        for (int i = 0; i < n; i++)
+        {
+            int variable = cellsOfType[i];
+            if (i < n - 1)
+                solver.addClause({-variable, counter[i][0]});
+            if (i > 0)
+            {
+                solver.addClause({-variable, -counter[i - 1][limit - 1]});
+                if (i < n - 1)
+                {
+                    solver.addClause({-counter[i - 1][0], counter[i][0]});
+                    for (int j = 1; j < limit; j++)
+                    {
+                        solver.addClause({-variable, -counter[i - 1][j - 1], counter[i][j]});
+                        solver.addClause({-counter[i - 1][j], counter[i][j]});
+                    }
+                }
+            }
+            else
+            {
+                for (int j = 1; j < limit; j++)
+                    solver.addClause({-counter[0][j]});
+            }
+        }
+    }
+    return placed;
+}
+
+/**
+ * @brief Parrallel recursion
+ *
+ * @return true if there is a solution
+ * @author Aubertin Emmanuel
+ */
+bool MacMahonGame::solve_parallel()
+{
+    resetSolveState();
+    last_exhaustive = true;
+    if (!isFeasible())
+        return false;
+    solution_found_parallel_recursion.store(false);
+    tasks = std::queue<Task>();
+    tasks.push(Task(0, 0, result, remainingCounts()));
+    std::vector<std::thread> threads;
+    for (int i = 0; i < std::thread::hardware_concurrency(); i++)
+    {
+        threads.emplace_back(&MacMahonGame::parallelRecursionThreadEngine, this);
+    }
+
+    // Wait for threads to complete
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    return solution_found_parallel_recursion.load();
+}
+
+/**
+ * @brief Parrallel recursion
+ *
+ * @param max_depth Specification of a depth
+ * @return true if there is a solution
+ * @author Aubertin Emmanuel
+ */
+bool MacMahonGame::solve_parallel(const int &max_depth)
+{
+    this->max_depth = max_depth;
+    return solve_parallel();
+}
+
+/**
+ * @brief Parrallel recursion
+ *
+ * @param inTask Current task to compute
+ * @param depth Current recurition depth
+ * @author Aubertin Emmanuel
+ */
+void MacMahonGame::parallelRecursion(Task inTask, int depth)
+{
+
+    if (solution_found_parallel_recursion.load())
+    {
+        return;
+    }
+
+    if (inTask.row == rows)
+    {
+        // Only the first solution is kept, the other threads stop at their next check
+        std::lock_guard<std::mutex> lock(taskMutex);
+        if (!solution_found_parallel_recursion.exchange(true))
+            result = inTask.result;
+        return;
+    }
+
+    uint64_t key = 0, check = 0;
+    bool memoized = dead_states && inTask.col == 0;
+    if (memoized)
+    {
+        uint64_t remainingKey, remainingCheck;
+        remainingSignature(inTask.remaining, remainingKey, remainingCheck);
+        frontierSignature(inTask.row, inTask.col, inTask.result, remainingKey, remainingCheck, key, check);
+        if (dead_states->contains(key, check))
+            return;
+    }
+
+    int nextRow = (inTask.col == cols - 1) ? inTask.row + 1 : inTask.row;
+    int nextCol = (inTask.col == cols - 1) ? 0 : inTask.col + 1;
+
+    // Only a node whose children were all explored here can be recorded as dead
+    bool exhaustive = true;
+    for (int type = 0; type < static_cast<int>(tile_types.size()); type++)
+    {
+        if (inTask.remaining[type] > 0 && isSafe(inTask.row, inTask.col, tile_types[type].tile, inTask.result))
+        {
+            inTask.remaining[type]--;
+            inTask.result[inTask.row][inTask.col] = tile_types[type].tile;
+            if (depth < max_depth)
+            {
+                std::lock_guard<std::mutex> lock(taskMutex);
+                tasks.push(Task(nextRow, nextCol, inTask.result, inTask.remaining));
+                inTask.remaining[type]++;
+                exhaustive = false;
+                continue;
+            }
+            parallelRecursion(Task(nextRow, nextCol, inTask.result, inTask.remaining), depth + 1);
+            if (!solution_found_parallel_recursion.load())
+                inTask.remaining[type]++;
+        }
+    }
+    if (memoized && exhaustive && !solution_found_parallel_recursion.load())
+        dead_states->insert(key, check, inTask.row * cols + inTask.col);
+}
+
+/**
+ * @brief Look the current board up in the dead state table, for solve(row, col) and countSolutions.
+ * Memoize at row boundaries only, inside a row the transpositions are too rare to pay for the probes.
+ *
+ * @param memoized Set to true if the node is memoized, the caller then records it once it failed
+ * @param key Set to the frontier signature of a memoized node
+ * @param check Set to the frontier check of a memoized node
+ * @return true if the subproblem is known to have no solution
+ */
+bool MacMahonGame::probeDeadState(int row, int col, bool &memoized, uint64_t &key, uint64_t &check)
+{
+    memoized = dead_states && col == 0;
+    if (!memoized)
+        return false;
+    frontierSignature(row, col, result, remaining_key, remaining_check, key, check);
+    return dead_states->contains(key, check);
+}
+
+/**
+ * @brief Use a table of dead frontiers to prune the search, nullptr to disable it
+ *
+ * @param table Table owned by the caller, may be shared between games and threads
+ */
+void MacMahonGame::setDeadStateTable(DeadStateTable *table)
+{
+    dead_states = table;
+}
+
+/**
+ * @brief Signature of the unused tiles as a multiset : the sum of the tile hashes
+ *
+ * @param remaining Number of unused copies of every tile type
+ */
+void MacMahonGame::remainingSignature(const std::vector<int> &remaining, uint64_t &key, uint64_t &check)
+{
+    key = 0;
+    check = 0;
+    for (size_t type = 0; type < tile_types.size(); type++)
+    {
+        key += type_keys[type] * static_cast<uint64_t>(remaining[type]);
+        check += type_checks[type] * static_cast<uint64_t>(remaining[type]);
+    }
+}
+
+/**
+ * @brief Signature of the subproblem left when (row, col) is the next cell to fill.
+ * It only depends on the colors the remaining cells must match and on the remaining tiles,
+ * not on the order the previous cells were filled in.
+ *
+ * @param board Board filled up to (row, col) excluded
+ * @param remainingKey Signature of the unused tiles
+ * @param remainingCheck Second signature of the unused tiles
+ */
+void MacMahonGame::frontierSignature(int row, int col, const std::vector<std::vector<Tile>> &board, uint64_t remainingKey, uint64_t remainingCheck, uint64_t &key, uint64_t &check)
+{
+    uint64_t position = static_cast<uint64_t>(row * cols + col);
+    key = mixHash(remainingKey, position);
+    check = mixHash(remainingCheck, position);
+    if (row == 0 && col == 0)
+        return;
+
+    // Frame color, then the bottom colors above the remaining cells, then the left color of (row, col)
+    key = mixHash(key, board[0][0].top);
+    check = mixHash(check, board[0][0].top);
+    for (int j = 0; j < cols; j++)
+    {
+        if (j < col)
+        {
+            key = mixHash(key, board[row][j].bottom);
+            check = mixHash(check, board[row][j].bottom);
+        }
+        else if (row > 0)
+        {
+            key = mixHash(key, board[row - 1][j].bottom);
+            check = mixHash(check, board[row - 1][j].bottom);
+        }
+    }
+    if (col > 0)
+    {
+        key = mixHash(key, board[row][col - 1].right);
+        check = mixHash(check, board[row][col - 1].right);
+    }
+}
+
+/**
+ * @brief Use one copy of a tile type and keep the remaining tiles signature up to date
+ *
+ * @param type index in tile_types
+ */
+void MacMahonGame::takeTile(int type)
+{
+    tile_types[type].remaining--;
+    remaining_key -= type_keys[type];
+    remaining_check -= type_checks[type];
+}
+
+/**
+ * @brief Give back one copy of a tile type and keep the remaining tiles signature up to date
+ *
+ * @param type index in tile_types
+ */
+void MacMahonGame::putBackTile(int type)
+{
+    tile_types[type].remaining++;
+    remaining_key += type_keys[type];
+    remaining_check += type_checks[type];
+}
+
+/**
+ * @brief Number of unused copies of every tile type
+ *
+ * @return std::vector<int>
+ */
+std::vector<int> MacMahonGame::remainingCounts()
+{
+    std::vector<int> remaining;
+    remaining.reserve(tile_types.size());
+    for (const TileType &type : tile_types)
+    {
+        remaining.push_back(type.remaining);
+    }
+    return remaining;
+}
+
+/**
+ * @brief Number of solutions counted with interchangeable copies merged, times this factor,
+ * gives the count with every copy considered different (all tiles are placed)
+ *
+ * @return unsigned long long
+ */
+unsigned long long MacMahonGame::multiplicity()
+{
+    unsigned long long factor = 1;
+    for (const TileType &type : tile_types)
+    {
+        for (int copy = type.count; copy > 1; copy--)
+            factor *= copy;
+    }
+    return factor;
+}
+
+/**
+ * @brief Running Task in thread
+ *
+ * @author Aubertin Emmanuel
+ */
+void MacMahonGame::parallelRecursionThreadEngine()
+{
+    while (!solution_found_parallel_recursion.load())
+    {
+        Task currentTask;
+        {
+            std::lock_guard<std::mutex> lock(taskMutex);
+            if (tasks.empty())
+                return;
             currentTask = tasks.front();
             tasks.pop();
         }
 
         parallelRecursion(currentTask, 0);
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Solver wrapper consulting a cache of prior outcomes before searching
+ *
+ * @param cache Cache shared between puzzles
+ * @param solver Solver to run on a cache miss
+ * @param symmetric Also match puzzles that are a rotation of a cached one
+ * @return true if there is a solution
+ */
+bool MacMahonGame::solve_cached(SolutionCache &cache, const std::function<bool()> &solver, bool symmetric)
+{
+    int transform = 0;
+    std::string key = fingerprint(transform);
+    std::vector<std::string> canonical = canonicalTokens(transform);
+
+    CacheEntry entry;
+    bool hit = cache.lookup(key, entry, symmetric ? -1 : transform);
+    if (hit)
+    {
+        if (entry.outcome == CacheOutcome::Unsolvable)
+        {
+            last_exhaustive = true;
+            return false;
+        }
+        if (!entry.permutation.empty() && applyPermutation(entry.permutation, canonical, transform))
+            return true;
+    }
+
+    bool solved = solver();
+    if (!hit)
+        entry = CacheEntry();
+    if (solved)
+    {
+        // Keep a known solution count
+        if (entry.outcome != CacheOutcome::Count)
+            entry.outcome = CacheOutcome::Solved;
+        entry.permutation = solutionPermutation(canonical, transform);
+    }
+    else if (last_exhaustive)
+    {
+        entry.outcome = CacheOutcome::Unsolvable;
+    }
+    else
+    {
+        // A search stopped on its budget proves nothing
+        return false;
+    }
+    entry.transform = transform;
+    cache.store(key, entry);
+    return solved;
+}
+
+/**
+ * @brief Solution counter wrapper consulting a cache of prior outcomes before searching
+ *
+ * @param cache Cache shared between puzzles
+ * @param counter Counter to run on a cache miss, count_solutions or count_dlx
+ * @param expand Count interchangeable copies of a tile as different solutions
+ * @param symmetric Also match puzzles that are a rotation of a cached one
+ * @return unsigned long long
+ */
+unsigned long long MacMahonGame::count_cached(SolutionCache &cache, const std::function<unsigned long long(bool)> &counter, bool expand, bool symmetric)
+{
+    // The cached count merges identical tiles, it can only be expanded when every tile is placed
+    if (expand && grid.size() != static_cast<size_t>(rows * cols))
+        return counter(expand);
+
+    int transform = 0;
+    std::string key = fingerprint(transform);
+    CacheEntry entry;
+    bool hit = cache.lookup(key, entry, symmetric ? -1 : transform);
+    if (hit && entry.outcome == CacheOutcome::Unsolvable)
+        return 0;
+    if (hit && entry.outcome == CacheOutcome::Count)
+        return expand ? entry.count * multiplicity() : entry.count;
+
+    unsigned long long count = counter(false);
+    if (!hit)
+        entry = CacheEntry();
+    entry.outcome = count == 0 ? CacheOutcome::Unsolvable : CacheOutcome::Count;
+    entry.count = count;
+    entry.transform = transform;
+    cache.store(key, entry);
+    return expand ? count * multiplicity() : count;
+}
+
+/**
+ * @brief Replace a tile of the input, the tile types are updated in place
+ *
+ * @param index Tile index in the input order
+ * @param tile New tile
+ * @return true if the index exists
+ */
+bool MacMahonGame::replaceTile(int index, const Tile &tile)
+{
+    if (index < 0 || index >= static_cast<int>(grid.size()))
+        return false;
+    eraseTileType(grid[index]);
+    grid[index] = tile;
+    insertTileType(tile);
+    return true;
+}
+
+/**
+ * @brief Add a tile at the end of the input
+ *
+ * @param tile New tile
+ */
+void MacMahonGame::addTile(const Tile &tile)
+{
+    grid.push_back(tile);
+    insertTileType(tile);
+}
+
+/**
+ * @brief Remove a tile of the input
+ *
+ * @param index Tile index in the input order
+ * @return true if the index exists
+ */
+bool MacMahonGame::removeTile(int index)
+{
+    if (index < 0 || index >= static_cast<int>(grid.size()))
+        return false;
+    eraseTileType(grid[index]);
+    grid.erase(grid.begin() + index);
+    return true;
+}
+
+/**
+ * @brief Find the type of a tile
+ *
+ * @return int index in tile_types, -1 if no tile of the puzzle has these colors
+ */
+int MacMahonGame::findTileType(const Tile &tile)
+{
+    for (int type = 0; type < static_cast<int>(tile_types.size()); type++)
+    {
+        const Tile &other = tile_types[type].tile;
+        if (other.top == tile.top && other.right == tile.right && other.bottom == tile.bottom && other.left == tile.left)
+            return type;
+    }
+    return -1;
+}
+
+/**
+ * @brief Add one copy of a tile to its type, creating the type if needed
+ */
+void MacMahonGame::insertTileType(const Tile &tile)
+{
+    int type = findTileType(tile);
+    if (type >= 0)
+    {
+        tile_types[type].count++;
+        tile_types[type].remaining++;
+        return;
+    }
+    tile_types.emplace_back(tile);
+    tile_types.back().tile.used = true;
+    type_keys.emplace_back();
+    type_checks.emplace_back();
+    tileSignature(tile, type_keys.back(), type_checks.back());
+}
+
+/**
+ * @brief Remove one copy of a tile from its type, removing the type with its last copy
+ */
+void MacMahonGame::eraseTileType(const Tile &tile)
+{
+    int type = findTileType(tile);
+    if (type < 0)
+        return;
+    tile_types[type].remaining = std::max(0, tile_types[type].remaining - 1);
+    if (--tile_types[type].count > 0)
+        return;
+    tile_types.erase(tile_types.begin() + type);
+    type_keys.erase(type_keys.begin() + type);
+    type_checks.erase(type_checks.begin() + type);
+}
+
+/**
+ * @brief Colors of a Tile in the input file order (left top right bottom)
+ */
+std::string MacMahonGame::tileToken(const Tile &tile)
+{
+    return {tile.left, tile.top, tile.right, tile.bottom};
+}
+
+/**
+ * @brief Rotate a Tile clockwise
+ *
+ * @param tile Tile to rotate
+ * @param quarterTurns Number of clockwise quarter turns
+ * @return Tile
+ */
+Tile MacMahonGame::rotateTile(const Tile &tile, int quarterTurns)
+{
+    Tile rotated = tile;
+    for (int i = 0; i < quarterTurns; i++)
+    {
+        rotated = Tile(rotated.bottom, rotated.left, rotated.top, rotated.right);
+    }
+    rotated.used = tile.used;
+    return rotated;
+}
+
+/**
+ * @brief Position of a cell once the whole board is rotated clockwise
+ *
+ * @param row index of the cell
+ * @param col index of the cell
+ * @param quarterTurns Number of clockwise quarter turns
+ */
+void MacMahonGame::rotateCell(int row, int col, int quarterTurns, int &outRow, int &outCol)
+{
+    int height = rows;
+    for (int i = 0; i < quarterTurns; i++)
+    {
+        int nextRow = col;
+        col = height - 1 - row;
+        row = nextRow;
+        height = (height == rows) ? cols : rows;
+    }
+    outRow = row;
+    outCol = col;
+}
+
+/**
+ * @brief Sorted tile tokens of the rotated puzzle, the tile order of the file does not matter
+ *
+ * @param transform Number of clockwise quarter turns applied to the puzzle
+ * @return std::vector<std::string>
+ */
+std::vector<std::string> MacMahonGame::canonicalTokens(int transform)
+{
+    std::vector<std::string> tokens;
+    tokens.reserve(grid.size());
+    for (const Tile &tile : grid)
+    {
+        tokens.emplace_back(tileToken(rotateTile(tile, transform)));
+    }
+    std::sort(tokens.begin(), tokens.end());
+    return tokens;
+}
+
+/**
+ * @brief Order-independent fingerprint of the puzzle : dimensions and tile multiset, the smallest
+ * one among the rotations keeping the board shape, so a puzzle and its rotations share one key
+ *
+ * @param transform Set to the number of quarter turns giving the fingerprint
+ * @return std::string
+ */
+std::string MacMahonGame::fingerprint(int &transform)
+{
+    std::string best;
+    transform = 0;
+    for (int quarterTurns = 0; quarterTurns < 4; quarterTurns++)
+    {
+        // A quarter turn changes the board shape unless it is a square
+        if (quarterTurns % 2 == 1 && rows != cols)
+            continue;
+        std::string key = std::to_string(cols) + "x" + std::to_string(rows) + ":";
+        for (const std::string &token : canonicalTokens(quarterTurns))
+        {
+            key += token + ",";
+        }
+        if (best.empty() || key < best)
+        {
+            best = key;
+            transform = quarterTurns;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Describe the current result as canonical tile indexes, in the canonical cell order
+ *
+ * @param canonical Tokens returned by canonicalTokens(transform)
+ * @param transform Number of quarter turns giving the canonical puzzle
+ * @return std::vector<int>
+ */
+std::vector<int> MacMahonGame::solutionPermutation(const std::vector<std::string> &canonical, int transform)
+{
+    std::unordered_map<std::string, std::vector<int>> freeIndexes;
+    for (int i = static_cast<int>(canonical.size()) - 1; i >= 0; i--)
+    {
+        freeIndexes[canonical[i]].push_back(i);
+    }
+
+    int canonicalCols = (transform % 2 == 1) ? rows : cols;
+    std::vector<int> permutation(rows * cols, -1);
+    for (int row = 0; row < rows; row++)
+    {
+        for (int col = 0; col < cols; col++)
+        {
+            std::vector<int> &indexes = freeIndexes[tileToken(rotateTile(result[row][col], transform))];
+            if (indexes.empty())
+                return {};
+            int canonicalRow, canonicalCol;
+            rotateCell(row, col, transform, canonicalRow, canonicalCol);
+            permutation[canonicalRow * canonicalCols + canonicalCol] = indexes.back();
+            indexes.pop_back();
+        }
+    }
+    return permutation;
+}
+
+/**
+ * @brief Rebuild the result from a cached permutation, remapped on the input tile order
+ *
+ * @param permutation Canonical tile index of every canonical cell
+ * @param canonical Tokens returned by canonicalTokens(transform)
+ * @param transform Number of quarter turns giving the canonical puzzle
+ * @return true if the permutation matches this puzzle
+ */
+bool MacMahonGame::applyPermutation(const std::vector<int> &permutation, const std::vector<std::string> &canonical, int transform)
+{
+    if (permutation.size() != static_cast<size_t>(rows * cols))
+        return false;
+
+    std::vector<int> placed(canonical.size(), 0);
+    int canonicalCols = (transform % 2 == 1) ? rows : cols;
+    std::vector<std::vector<Tile>> board = result;
+    for (int row = 0; row < rows; row++)
+    {
+        for (int col = 0; col < cols; col++)
+        {
+            int canonicalRow, canonicalCol;
+            rotateCell(row, col, transform, canonicalRow, canonicalCol);
+            int tileIndex = permutation[canonicalRow * canonicalCols + canonicalCol];
+            if (tileIndex < 0 || tileIndex >= static_cast<int>(canonical.size()) || placed[tileIndex]++)
+                return false;
+            const std::string &token = canonical[tileIndex];
+            board[row][col] = rotateTile(Tile(token[0], token[1], token[2], token[3]), (4 - transform) % 4);
+            board[row][col].used = true;
+        }
+    }
+    result = board;
+    return true;
+}
@@ -1,16 +1,22 @@
+#pragma once
 #include <vector>
 #include <string>
 #include <iostream>
 #include <atomic>
+#include <functional>
+#include <memory>
 #include "../ThreadPool/ThreadPool.hpp"
-
-struct Tile
-{
-    char top, right, bottom, left;
-    bool used = false;
-    Tile(char l = ' ', char t = ' ', char r = ' ', char b = ' ')
-        : top(t), right(r), bottom(b), left(l) {}
-};
+#include "../SolutionCache/SolutionCache.hpp"
+#include "../DeadStateTable/DeadStateTable.hpp"
+#include "../SearchEngine/SearchEngine.hpp"
+#include "../Tile/Tile.hpp"
+#include "../Renderer/Renderer.hpp"
+#include "../DancingLinks/DancingLinks.hpp"
+#include "../SatSolver/SatSolver.hpp"
+#include "../Feasibility/Feasibility.hpp"
+#include "../Scheduler/Scheduler.hpp"
+#include "../Puzzle/Puzzle.hpp"
+#include "../SolverContext/SolverContext.hpp"
 
 struct Task
 {
@@ -18,10 +24,10 @@ struct Task
     int row;
     int col;
     std::vector<std::vector<Tile>> result;
-    std::vector<Tile> grid;
-    Task() : row(0), col(0), result(), grid() {}
-    Task(int row, int col, std::vector<std::vector<Tile>> result, std::vector<Tile> grid)
-        : row(row), col(col), result(result), grid(grid) {}
+    std::vector<int> remaining; // Unused copies of every tile type
+    Task() : row(0), col(0), result(), remaining() {}
+    Task(int row, int col, std::vector<std::vector<Tile>> result, std::vector<int> remaining)
+        : row(row), col(col), result(result), remaining(remaining) {}
 };
 
 class MacMahonGame
@@ -31,6 +37,10 @@ public:
     std::atomic<bool> solution_found_parallel_recursion;
 
     MacMahonGame(const std::string &filename);
+    MacMahonGame(const Puzzle &puzzle);
+
+    // Necessary conditions checked in O(N), to run before any solver
+    FeasibilityReport checkFeasibility() const;
 
     // Solvers function
     bool solve();
@@ -38,33 +48,103 @@ public:
     bool solve_thread();
     bool solve_parallel(const int& max_depth);
     bool solve_parallel();
+    bool solve_cached(SolutionCache &cache, const std::function<bool()> &solver, bool symmetric = false);
+    bool solve_portfolio(std::string &winner);
+    bool solve_portfolio(const std::vector<SearchConfig> &configs, std::string &winner);
+    bool solve_restart(uint64_t seed, RestartSchedule schedule = RestartSchedule::Luby, uint64_t base_nodes = 1000, bool keep_nogoods = false);
+    bool solve_dlx();
+    bool solve_sat();
+    bool export_cnf(const std::string &path);
+    bool solve_incremental(uint64_t repair_nodes = 100000);
+    std::size_t schedule(PuzzleScheduler &scheduler, int priority = 0,
+                         PuzzleScheduler::Clock::time_point deadline = PuzzleScheduler::Clock::time_point::max());
+    bool collect(const ScheduledResult &scheduled);
+    unsigned long long count_solutions(bool expand = false);
+    unsigned long long count_dlx(bool expand = false);
+    unsigned long long count_cached(SolutionCache &cache, const std::function<unsigned long long(bool)> &counter, bool expand = false, bool symmetric = false);
+
+    // Edit the tile set in place, index in the input order
+    const std::vector<Tile> &getTiles() const { return grid; }
+    const std::vector<std::vector<Tile>> &getResult() const { return result; }
+    bool replaceTile(int index, const Tile &tile);
+    void addTile(const Tile &tile);
+    bool removeTile(int index);
+
+    // Statistics of the last solve_restart or solve_incremental
+    unsigned int getRestarts() const { return last_restarts; }
+    uint64_t getNodes() const { return last_nodes; }
+    int getRepairRadius() const { return last_repair_radius; }
+    // False when the last solver stopped on a budget before exploring every branch,
+    // its false answer is then not a proof that there is no solution
+    bool wasExhaustive() const { return last_exhaustive; }
+
+    // Failed subproblem memoization, the table can be shared between games and threads
+    void setDeadStateTable(DeadStateTable *table);
 
     // Print function
     void print();
     void printResult();
+    void setRenderMode(RenderMode mode);
 
 private:
     int rows, cols, max_depth;
     std::vector<Tile> grid;
+    std::vector<TileType> tile_types;
     std::vector<std::vector<Tile>> result;
     std::mutex taskMutex;
     std::queue<Task> tasks;
+    DeadStateTable *dead_states = nullptr;
+    unsigned int last_restarts = 0;
+    uint64_t last_nodes = 0;
+    int last_repair_radius = -1;
+    bool last_exhaustive = true;
+    std::vector<uint64_t> type_keys, type_checks;     // Signature of every tile type
+    uint64_t remaining_key = 0, remaining_check = 0; // Signature of the unused tiles
 
     // Utility function
-    std::vector<Tile> parseTilesFromFile(const std::string &filename);
-    std::vector<std::string> split(const std::string &s, char delimiter);
-    std::vector<char> convertToCharVector(const std::vector<std::string> &strVec);
+    void resetSolveState();
+    bool isFeasible() const;
+    int findTileType(const Tile &tile);
+    void insertTileType(const Tile &tile);
+    void eraseTileType(const Tile &tile);
+    bool isBoardSolved();
+    void takeTile(int type);
+    void putBackTile(int type);
+    std::vector<int> remainingCounts();
+    unsigned long long multiplicity();
+    unsigned long long countSolutions(int row, int col, bool expand);
+
+    // Cache function
+    std::string tileToken(const Tile &tile);
+    Tile rotateTile(const Tile &tile, int quarterTurns);
+    void rotateCell(int row, int col, int quarterTurns, int &outRow, int &outCol);
+    std::vector<std::string> canonicalTokens(int transform);
+    std::string fingerprint(int &transform);
+    std::vector<int> solutionPermutation(const std::vector<std::string> &canonical, int transform);
+    bool applyPermutation(const std::vector<int> &permutation, const std::vector<std::string> &canonical, int transform);
 
     // Print function
-    std::string getColorCode(char);
-    void print(std::vector<Tile> inGrid);
-    std::vector<Tile> flatten(const std::vector<std::vector<Tile>> &);
+    Renderer renderer;
 
     // Verification function
     bool isBorderCorrect();
     bool isSafe(int row, int col, const Tile &tile);
     bool isSafe(int row, int col, const Tile &tile, const std::vector<std::vector<Tile>>& board);
 
+    // Dead state signature
+    void remainingSignature(const std::vector<int> &remaining, uint64_t &key, uint64_t &check);
+    void frontierSignature(int row, int col, const std::vector<std::vector<Tile>> &board, uint64_t remainingKey, uint64_t remainingCheck, uint64_t &key, uint64_t &check);
+    bool probeDeadState(int row, int col, bool &memoized, uint64_t &key, uint64_t &check);
+
+    // Exact cover
+    std::vector<char> colors();
+    int colorIndex(const std::vector<char> &palette, char color);
+    bool fitsFrame(int row, int col, const Tile &tile, char frame);
+    std::unique_ptr<DancingLinks> exactCover(char frame, std::vector<std::pair<int, int>> &placements);
+
+    // SAT encoding
+    std::vector<std::vector<int>> satEncoding(SatSolver &solver);
+
     // ParallelRecursion
     void parallelRecursion(Task inTask, int);
     void parallelRecursionThreadEngine();
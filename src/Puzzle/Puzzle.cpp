@@ -0,0 +1,141 @@
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include "Puzzle.hpp"
+#include "../DeadStateTable/DeadStateTable.hpp"
+
+namespace
+{
+    /**
+     * @brief Optimize split of string
+     *
+     * @param s String to split
+     * @param delimiter Char who delimits the string
+     * @return std::string
+     * @author Aubertin Emmanuel
+     */
+    std::vector<std::string> split(const std::string &s, char delimiter)
+    {
+        std::vector<std::string> tokens;
+        tokens.reserve(s.size() / 5);
+
+        std::istringstream tokenStream(s);
+        std::string token;
+
+        while (std::getline(tokenStream, token, delimiter))
+        {
+            tokens.emplace_back(std::move(token));
+        }
+
+        return tokens;
+    }
+
+    std::vector<char> convertToCharVector(const std::vector<std::string> &strVec)
+    {
+        std::vector<char> charVec;
+
+        // Calculate total characters
+        size_t totalChars = 0;
+        for (const auto &str : strVec)
+        {
+            totalChars += str.size();
+        }
+        charVec.reserve(totalChars);
+
+        // Populate charVec using std::copy
+        for (const auto &str : strVec)
+        {
+            std::copy(str.begin(), str.end(), std::back_inserter(charVec));
+        }
+
+        return charVec;
+    }
+}
+
+/**
+ * @brief Parse a puzzle file : "cols rows", then one "left top right bottom" tile per line
+ *
+ * @param filename Puzzle file
+ */
+Puzzle::Puzzle(const std::string &filename)
+{
+    std::ifstream file(filename);
+    std::string line;
+    if (!std::getline(file, line))
+    {
+        throw std::runtime_error("❌ \033[1;31m Error :\033[0m Failed to read the header from the file: " + filename + " ❌");
+    }
+
+    std::vector<std::string> vectLine = split(line, ' ');
+    if (vectLine.size() != 2)
+    {
+        throw std::runtime_error("❌ \033[1;31m Error :\033[0mUnexpected header format in the file: " + filename + " ❌");
+    }
+    cols = std::stoi(vectLine[0]);
+    rows = std::stoi(vectLine[1]);
+    if (rows <= 0 || cols <= 0)
+    {
+        throw std::runtime_error("❌ \033[1;31m Error :\033[0m The board size must be positive in the file: " + filename + " ❌");
+    }
+
+    int lineNum = 2;
+    while (std::getline(file, line))
+    {
+        std::vector<std::string> vectLine = split(line, ' ');
+        if (vectLine.size() != 4)
+        {
+            throw std::runtime_error("❌ \033[1;31m Error :\033[0mUnexpected line format at " + std::to_string(lineNum) + "\nPlease check the file: " + filename + " ❌");
+        }
+        std::vector<char> tileColors = convertToCharVector(vectLine);
+        tiles.emplace_back(Tile(tileColors[0], tileColors[1], tileColors[2], tileColors[3]));
+        lineNum++;
+    }
+    groupTileTypes();
+}
+
+/**
+ * @brief Construct a puzzle from tiles already in memory
+ *
+ * @param tiles Tiles in the input order
+ */
+Puzzle::Puzzle(int rows, int cols, const std::vector<Tile> &tiles)
+    : rows(rows), cols(cols), tiles(tiles)
+{
+    if (rows <= 0 || cols <= 0)
+    {
+        throw std::runtime_error("❌ \033[1;31m Error :\033[0m The board size must be positive ❌");
+    }
+    groupTileTypes();
+}
+
+/**
+ * @brief Group identical tiles into tile types, in order of first appearance.
+ * Solvers branch on types so interchangeable copies are never explored twice.
+ */
+void Puzzle::groupTileTypes()
+{
+    std::unordered_map<std::string, int> typeIndex;
+    for (const Tile &tile : tiles)
+    {
+        const std::string token{tile.left, tile.top, tile.right, tile.bottom};
+        auto it = typeIndex.find(token);
+        if (it == typeIndex.end())
+        {
+            typeIndex.emplace(token, static_cast<int>(tile_types.size()));
+            tile_types.emplace_back(tile);
+            tile_types.back().tile.used = true;
+            continue;
+        }
+        tile_types[it->second].count++;
+        tile_types[it->second].remaining++;
+    }
+
+    type_keys.resize(tile_types.size());
+    type_checks.resize(tile_types.size());
+    for (size_t type = 0; type < tile_types.size(); type++)
+    {
+        tileSignature(tile_types[type].tile, type_keys[type], type_checks[type]);
+    }
+    feasibility = analyzeFeasibility(rows, cols, tiles);
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../Tile/Tile.hpp"
+#include "../Feasibility/Feasibility.hpp"
+
+// Immutable puzzle : board size, tiles in the input order and identical tiles
+// grouped into types. Parsed once, then shared read-only by any number of
+// concurrent solves.
+class Puzzle
+{
+public:
+    explicit Puzzle(const std::string &filename);
+    Puzzle(int rows, int cols, const std::vector<Tile> &tiles);
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    const std::vector<Tile> &getTiles() const { return tiles; }
+    const std::vector<TileType> &getTileTypes() const { return tile_types; }
+    uint64_t getTypeKey(int type) const { return type_keys[type]; }
+    uint64_t getTypeCheck(int type) const { return type_checks[type]; }
+    const FeasibilityReport &getFeasibility() const { return feasibility; }
+
+private:
+    int rows = 0, cols = 0;
+    std::vector<Tile> tiles;
+    std::vector<TileType> tile_types;
+    std::vector<uint64_t> type_keys, type_checks; // Signature of every tile type
+    FeasibilityReport feasibility;
+
+    void groupTileTypes();
+};
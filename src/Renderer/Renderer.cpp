@@ -0,0 +1,152 @@
+#include <array>
+#include <iostream>
+#include <unistd.h>
+#include "Renderer.hpp"
+
+namespace
+{
+    constexpr int TILE_HALF = 5; // Lines of the top half of a tile, middle line included
+    constexpr const char *RESET_CODE = "\033[0m";
+    constexpr std::size_t CODE_SIZE = 5; // Every color code has the size of the reset code
+
+    constexpr std::array<const char *, 256> makeColorTable()
+    {
+        std::array<const char *, 256> table{};
+        for (auto &code : table)
+            code = RESET_CODE;
+        table['R'] = "\033[41m"; // Red background
+        table['G'] = "\033[42m"; // Green background
+        table['B'] = "\033[44m"; // Blue background
+        return table;
+    }
+    constexpr std::array<const char *, 256> COLOR_TABLE = makeColorTable();
+}
+
+/**
+ * @brief Render a grid of tiles stored row by row
+ *
+ * @param tiles Tiles, cells after the last tile are left blank
+ * @return const std::string& the frame, valid until the next render
+ */
+const std::string &Renderer::render(int rows, int cols, const std::vector<Tile> &tiles)
+{
+    cells.assign(static_cast<std::size_t>(rows * cols), nullptr);
+    for (std::size_t i = 0; i < cells.size() && i < tiles.size(); i++)
+    {
+        cells[i] = &tiles[i];
+    }
+    renderCells(rows, cols);
+    return buffer;
+}
+
+/**
+ * @brief Render a board
+ *
+ * @return const std::string& the frame, valid until the next render
+ */
+const std::string &Renderer::render(int rows, int cols, const std::vector<std::vector<Tile>> &board)
+{
+    cells.assign(static_cast<std::size_t>(rows * cols), nullptr);
+    for (int row = 0; row < rows && row < static_cast<int>(board.size()); row++)
+    {
+        for (int col = 0; col < cols && col < static_cast<int>(board[row].size()); col++)
+        {
+            cells[row * cols + col] = &board[row][col];
+        }
+    }
+    renderCells(rows, cols);
+    return buffer;
+}
+
+void Renderer::print(int rows, int cols, const std::vector<Tile> &tiles)
+{
+    render(rows, cols, tiles);
+    write();
+}
+
+void Renderer::print(int rows, int cols, const std::vector<std::vector<Tile>> &board)
+{
+    render(rows, cols, board);
+    write();
+}
+
+/**
+ * @brief Append a run of one color, a colored blank or the color letter in plain mode
+ */
+void Renderer::appendSegment(char color, int width)
+{
+    if (width == 0)
+        return;
+    if (mode == RenderMode::Plain)
+    {
+        buffer.append(width, color == ' ' ? '.' : color);
+        return;
+    }
+    buffer.append(COLOR_TABLE[static_cast<unsigned char>(color)]);
+    buffer.append(width, ' ');
+    buffer.append(RESET_CODE);
+}
+
+/**
+ * @brief Draw every cell as four triangles, each tile row takes 2 * TILE_HALF - 1 lines
+ */
+void Renderer::renderCells(int rows, int cols)
+{
+    static const Tile blank;
+    buffer.clear();
+
+    if (mode == RenderMode::Machine)
+    {
+        buffer.reserve(16 + cells.size() * 8);
+        buffer.append(std::to_string(cols)).append(1, ' ').append(std::to_string(rows)).append(1, '\n');
+        for (const Tile *tile : cells)
+        {
+            const Tile &cell = tile ? *tile : blank;
+            const char line[] = {cell.left, ' ', cell.top, ' ', cell.right, ' ', cell.bottom, '\n'};
+            buffer.append(line, sizeof(line));
+        }
+        return;
+    }
+
+    // A tile line has three segments, at most 4 * TILE_HALF characters wide, and a separator
+    std::size_t segmentCodes = mode == RenderMode::Color ? 3 * 2 * CODE_SIZE : 0;
+    std::size_t tileLine = segmentCodes + 4 * TILE_HALF + 1;
+    buffer.reserve(static_cast<std::size_t>(rows) * (2 * TILE_HALF * (cols * tileLine + 1)));
+
+    for (int row = 0; row < rows; ++row)
+    {
+        // Top half including the middle line, then the bottom half
+        for (int line = 1; line <= 2 * TILE_HALF - 1; ++line)
+        {
+            int side = line <= TILE_HALF ? line : 2 * TILE_HALF - line;
+            for (int index = cols * row; index < cols * row + cols; ++index)
+            {
+                const Tile &tile = cells[index] ? *cells[index] : blank;
+                appendSegment(tile.left, 2 * side);
+                appendSegment(line <= TILE_HALF ? tile.top : tile.bottom, 4 * (TILE_HALF - side));
+                appendSegment(tile.right, 2 * side);
+                buffer.push_back(' ');
+            }
+            buffer.push_back('\n');
+        }
+        buffer.push_back('\n');
+    }
+}
+
+/**
+ * @brief Write the frame to stdout in one syscall (retrying on a partial write)
+ */
+void Renderer::write() const
+{
+    std::cout.flush();
+    const char *data = buffer.data();
+    std::size_t left = buffer.size();
+    while (left > 0)
+    {
+        ssize_t written = ::write(STDOUT_FILENO, data, left);
+        if (written <= 0)
+            return;
+        data += written;
+        left -= static_cast<std::size_t>(written);
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "../Tile/Tile.hpp"
+
+enum class RenderMode
+{
+    Color,  // ANSI background colors
+    Plain,  // Same drawing with the color letters, for terminals without colors
+    Machine // The board in the input file format, one tile per line in row-major order
+};
+
+// Builds a whole frame in one reused buffer and writes it with a single syscall
+class Renderer
+{
+public:
+    Renderer(RenderMode mode = RenderMode::Color) : mode(mode) {}
+
+    void setMode(RenderMode mode) { this->mode = mode; }
+    RenderMode getMode() const { return mode; }
+
+    const std::string &render(int rows, int cols, const std::vector<Tile> &tiles);
+    const std::string &render(int rows, int cols, const std::vector<std::vector<Tile>> &board);
+    void print(int rows, int cols, const std::vector<Tile> &tiles);
+    void print(int rows, int cols, const std::vector<std::vector<Tile>> &board);
+
+private:
+    RenderMode mode;
+    std::string buffer;
+    std::vector<const Tile *> cells; // Row-major, nullptr for a missing tile
+
+    void renderCells(int rows, int cols);
+    void appendSegment(char color, int width);
+    void write() const;
+};
@@ -0,0 +1,351 @@
+#include <algorithm>
+#include "SatSolver.hpp"
+
+/**
+ * @brief Create a new variable
+ *
+ * @return int its DIMACS index, starting at 1
+ */
+int SatSolver::newVariable()
+{
+    int variable = static_cast<int>(assigns.size());
+    assigns.push_back(-1);
+    phase.push_back(0);
+    level.push_back(0);
+    reason.push_back(-1);
+    activity.push_back(0.0);
+    heap_index.push_back(-1);
+    seen.push_back(0);
+    watches.emplace_back();
+    watches.emplace_back();
+    heapInsert(variable);
+    return variable + 1;
+}
+
+/**
+ * @brief Add a clause, must be called before solve
+ *
+ * @param literals DIMACS literals of existing variables
+ */
+void SatSolver::addClause(const std::vector<int> &literals)
+{
+    dimacs.push_back(literals);
+    if (inconsistent)
+        return;
+
+    std::vector<int> clause;
+    for (int dimacsLiteral : literals)
+    {
+        int literal = toLiteral(dimacsLiteral);
+        if (std::find(clause.begin(), clause.end(), literal ^ 1) != clause.end())
+            return; // Always true
+        if (std::find(clause.begin(), clause.end(), literal) == clause.end())
+            clause.push_back(literal);
+    }
+    if (clause.empty())
+    {
+        inconsistent = true;
+        return;
+    }
+    if (clause.size() == 1)
+    {
+        if (literalValue(clause[0]) == 0)
+            inconsistent = true;
+        else if (literalValue(clause[0]) == -1)
+            enqueue(clause[0], -1);
+        return;
+    }
+    watches[clause[0]].push_back(static_cast<int>(clauses.size()));
+    watches[clause[1]].push_back(static_cast<int>(clauses.size()));
+    clauses.push_back(std::move(clause));
+}
+
+/**
+ * @brief Write the clauses in the DIMACS CNF format
+ */
+void SatSolver::writeDimacs(std::ostream &out) const
+{
+    out << "p cnf " << variables() << ' ' << dimacs.size() << '\n';
+    for (const std::vector<int> &clause : dimacs)
+    {
+        for (int literal : clause)
+            out << literal << ' ';
+        out << "0\n";
+    }
+}
+
+/**
+ * @return int -1 unassigned, 0 false, 1 true
+ */
+int SatSolver::literalValue(int literal) const
+{
+    int8_t assigned = assigns[literal >> 1];
+    if (assigned < 0)
+        return -1;
+    return (literal & 1) ? 1 - assigned : assigned;
+}
+
+void SatSolver::enqueue(int literal, int from)
+{
+    int variable = literal >> 1;
+    assigns[variable] = (literal & 1) ? 0 : 1;
+    level[variable] = decisionLevel();
+    reason[variable] = from;
+    trail.push_back(literal);
+}
+
+/**
+ * @brief Unit propagation with two watched literals, the implied literal is kept first in its clause
+ *
+ * @return int index of a falsified clause, -1 if none
+ */
+int SatSolver::propagate()
+{
+    while (propagated < trail.size())
+    {
+        int falseLiteral = trail[propagated++] ^ 1;
+        std::vector<int> &watching = watches[falseLiteral];
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < watching.size(); i++)
+        {
+            int index = watching[i];
+            std::vector<int> &clause = clauses[index];
+            if (clause[0] == falseLiteral)
+                std::swap(clause[0], clause[1]);
+            if (literalValue(clause[0]) == 1)
+            {
+                watching[kept++] = index;
+                continue;
+            }
+
+            bool moved = false;
+            for (std::size_t k = 2; k < clause.size(); k++)
+            {
+                if (literalValue(clause[k]) != 0)
+                {
+                    std::swap(clause[1], clause[k]);
+                    watches[clause[1]].push_back(index);
+                    moved = true;
+                    break;
+                }
+            }
+            if (moved)
+                continue;
+
+            watching[kept++] = index;
+            if (literalValue(clause[0]) == 0)
+            {
+                for (i++; i < watching.size(); i++)
+                    watching[kept++] = watching[i];
+                watching.resize(kept);
+                propagated = trail.size();
+                return index;
+            }
+            enqueue(clause[0], index);
+        }
+        watching.resize(kept);
+    }
+    return -1;
+}
+
+/**
+ * @brief First UIP conflict analysis
+ *
+ * @param conflict Falsified clause
+ * @param learnt Set to the learnt clause, asserting literal first
+ * @param backtrackLevel Set to the level where the learnt clause becomes unit
+ */
+void SatSolver::analyze(int conflict, std::vector<int> &learnt, int &backtrackLevel)
+{
+    learnt.assign(1, -1);
+    int pending = 0;
+    int literal = -1;
+    std::size_t index = trail.size();
+    do
+    {
+        const std::vector<int> &clause = clauses[conflict];
+        for (std::size_t k = (literal == -1) ? 0 : 1; k < clause.size(); k++)
+        {
+            int variable = clause[k] >> 1;
+            if (seen[variable] || level[variable] == 0)
+                continue;
+            seen[variable] = 1;
+            bump(variable);
+            if (level[variable] >= decisionLevel())
+                pending++;
+            else
+                learnt.push_back(clause[k]);
+        }
+        while (!seen[trail[--index] >> 1])
+            ;
+        literal = trail[index];
+        conflict = reason[literal >> 1];
+        seen[literal >> 1] = 0;
+        pending--;
+    } while (pending > 0);
+    learnt[0] = literal ^ 1;
+
+    backtrackLevel = 0;
+    for (std::size_t k = 1; k < learnt.size(); k++)
+    {
+        seen[learnt[k] >> 1] = 0;
+        if (level[learnt[k] >> 1] > backtrackLevel)
+        {
+            backtrackLevel = level[learnt[k] >> 1];
+            std::swap(learnt[1], learnt[k]);
+        }
+    }
+}
+
+void SatSolver::cancelUntil(int target)
+{
+    if (decisionLevel() <= target)
+        return;
+    for (std::size_t i = trail.size(); i > static_cast<std::size_t>(trail_limits[target]); i--)
+    {
+        int variable = trail[i - 1] >> 1;
+        phase[variable] = assigns[variable];
+        assigns[variable] = -1;
+        reason[variable] = -1;
+        if (heap_index[variable] < 0)
+            heapInsert(variable);
+    }
+    trail.resize(trail_limits[target]);
+    trail_limits.resize(target);
+    propagated = trail.size();
+}
+
+void SatSolver::bump(int variable)
+{
+    activity[variable] += activity_increment;
+    if (activity[variable] > 1e100)
+    {
+        for (double &value : activity)
+            value *= 1e-100;
+        activity_increment *= 1e-100;
+    }
+    if (heap_index[variable] >= 0)
+        heapUp(heap_index[variable]);
+}
+
+int SatSolver::pickBranchVariable()
+{
+    while (!heap.empty())
+    {
+        int variable = heapPop();
+        if (assigns[variable] < 0)
+            return variable;
+    }
+    return -1;
+}
+
+/**
+ * @brief Search a model of the clauses
+ *
+ * @return true if the clauses are satisfiable, the model is read with value
+ */
+bool SatSolver::solve()
+{
+    if (inconsistent || propagate() >= 0)
+        return false;
+
+    std::vector<int> learnt;
+    double restartLimit = 100;
+    uint64_t conflictsSinceRestart = 0;
+    while (true)
+    {
+        int conflict = propagate();
+        if (conflict >= 0)
+        {
+            conflicts++;
+            conflictsSinceRestart++;
+            if (decisionLevel() == 0)
+                return false;
+            int backtrackLevel;
+            analyze(conflict, learnt, backtrackLevel);
+            cancelUntil(backtrackLevel);
+            if (learnt.size() == 1)
+            {
+                enqueue(learnt[0], -1);
+            }
+            else
+            {
+                int index = static_cast<int>(clauses.size());
+                watches[learnt[0]].push_back(index);
+                watches[learnt[1]].push_back(index);
+                clauses.push_back(learnt);
+                enqueue(learnt[0], index);
+            }
+            activity_increment /= 0.95;
+            continue;
+        }
+
+        if (conflictsSinceRestart >= restartLimit)
+        {
+            conflictsSinceRestart = 0;
+            restartLimit *= 1.5;
+            cancelUntil(0);
+            continue;
+        }
+
+        int variable = pickBranchVariable();
+        if (variable < 0)
+            return true;
+        decisions++;
+        trail_limits.push_back(static_cast<int>(trail.size()));
+        enqueue(2 * variable + (phase[variable] == 1 ? 0 : 1), -1);
+    }
+}
+
+void SatSolver::heapInsert(int variable)
+{
+    heap_index[variable] = static_cast<int>(heap.size());
+    heap.push_back(variable);
+    heapUp(heap_index[variable]);
+}
+
+int SatSolver::heapPop()
+{
+    int top = heap[0];
+    heap_index[top] = -1;
+    heap[0] = heap.back();
+    heap.pop_back();
+    if (!heap.empty())
+    {
+        heap_index[heap[0]] = 0;
+        heapDown(0);
+    }
+    return top;
+}
+
+void SatSolver::heapUp(int position)
+{
+    int variable = heap[position];
+    while (position > 0 && activity[heap[(position - 1) / 2]] < activity[variable])
+    {
+        heap[position] = heap[(position - 1) / 2];
+        heap_index[heap[position]] = position;
+        position = (position - 1) / 2;
+    }
+    heap[position] = variable;
+    heap_index[variable] = position;
+}
+
+void SatSolver::heapDown(int position)
+{
+    int variable = heap[position];
+    int size = static_cast<int>(heap.size());
+    while (2 * position + 1 < size)
+    {
+        int child = 2 * position + 1;
+        if (child + 1 < size && activity[heap[child + 1]] > activity[heap[child]])
+            child++;
+        if (activity[heap[child]] <= activity[variable])
+            break;
+        heap[position] = heap[child];
+        heap_index[heap[position]] = position;
+        position = child;
+    }
+    heap[position] = variable;
+    heap_index[variable] = position;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// Small CDCL SAT solver : two watched literals, first UIP clause learning,
+// VSIDS decisions, phase saving and geometric restarts.
+// Literals use the DIMACS convention : variable v is v, its negation is -v.
+class SatSolver
+{
+public:
+    int newVariable();
+    int variables() const { return static_cast<int>(assigns.size()); }
+    void addClause(const std::vector<int> &literals);
+    bool solve();
+    bool value(int variable) const { return assigns[variable - 1] == 1; }
+    void writeDimacs(std::ostream &out) const;
+
+    uint64_t getConflicts() const { return conflicts; }
+    uint64_t getDecisions() const { return decisions; }
+
+private:
+    std::vector<std::vector<int>> dimacs;  // Clauses as given, for the export
+    std::vector<std::vector<int>> clauses; // Internal literals, learnt clauses appended
+    std::vector<std::vector<int>> watches; // Clauses watching every literal
+    std::vector<int8_t> assigns;           // -1 unassigned, 0 false, 1 true
+    std::vector<int8_t> phase;             // Last value of every variable
+    std::vector<int> level, reason;
+    std::vector<int> trail, trail_limits;
+    std::size_t propagated = 0;
+    bool inconsistent = false;
+
+    std::vector<double> activity;
+    double activity_increment = 1.0;
+    std::vector<int> heap, heap_index; // Max-heap of variables by activity
+    std::vector<char> seen;
+
+    uint64_t conflicts = 0, decisions = 0;
+
+    static int toLiteral(int dimacsLiteral) { return dimacsLiteral > 0 ? 2 * (dimacsLiteral - 1) : 2 * (-dimacsLiteral - 1) + 1; }
+    int literalValue(int literal) const;
+    int decisionLevel() const { return static_cast<int>(trail_limits.size()); }
+    void enqueue(int literal, int from);
+    int propagate();
+    void analyze(int conflict, std::vector<int> &learnt, int &backtrackLevel);
+    void cancelUntil(int target);
+    void bump(int variable);
+    int pickBranchVariable();
+
+    void heapInsert(int variable);
+    int heapPop();
+    void heapUp(int position);
+    void heapDown(int position);
+};
@@ -0,0 +1,136 @@
+#include "Scheduler.hpp"
+
+/**
+ * @brief Construct a new Puzzle Scheduler and start its workers
+ *
+ * @param workers Number of worker threads, at least one
+ * @param yield_every Nodes searched by a puzzle before the worker picks the next one
+ */
+PuzzleScheduler::PuzzleScheduler(unsigned int workers, uint64_t yield_every)
+    : yield_every(yield_every == 0 ? 1 : yield_every)
+{
+    for (unsigned int i = 0; i < (workers == 0 ? 1 : workers); i++)
+    {
+        this->workers.emplace_back(&PuzzleScheduler::work, this);
+    }
+}
+
+/**
+ * @brief Destroy the Puzzle Scheduler, the unfinished puzzles are dropped
+ */
+PuzzleScheduler::~PuzzleScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    ready_condition.notify_all();
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Queue a puzzle, an infeasible one is finished at once as Exhausted without a slice
+ *
+ * @param types Tile types of the puzzle
+ * @param priority Higher runs first
+ * @param deadline The search is cancelled once it passes
+ * @return std::size_t id of the result
+ */
+std::size_t PuzzleScheduler::submit(int rows, int cols, const std::vector<TileType> &types, int priority, Clock::time_point deadline)
+{
+    std::unique_ptr<Job> job = std::make_unique<Job>();
+    job->priority = priority;
+    job->deadline = deadline;
+    job->submitted = Clock::now();
+
+    std::vector<Tile> tiles;
+    for (const TileType &type : types)
+    {
+        tiles.insert(tiles.end(), type.count, type.tile);
+    }
+    if (!analyzeFeasibility(rows, cols, tiles).feasible())
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ScheduledResult &result = results.emplace_back();
+        result.status = SearchStatus::Exhausted;
+        result.elapsed = Clock::now() - job->submitted;
+        jobs.emplace_back(); // jobs stays indexed by id
+        return results.size() - 1;
+    }
+    job->engine = std::make_unique<SearchEngine>(rows, cols, types, SearchConfig{"scheduled"});
+    job->task = job->engine->runCooperative(yield_every);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    job->id = results.size();
+    results.emplace_back();
+    ready.push(job.get());
+    jobs.push_back(std::move(job));
+    pending++;
+    ready_condition.notify_one();
+    return jobs.back()->id;
+}
+
+/**
+ * @brief Block until every submitted puzzle is finished
+ */
+void PuzzleScheduler::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    idle_condition.wait(lock, [this]
+                        { return pending == 0; });
+}
+
+bool PuzzleScheduler::RunsLater::operator()(const Job *a, const Job *b) const
+{
+    if (a->priority != b->priority)
+        return a->priority < b->priority;
+    if (a->deadline != b->deadline)
+        return a->deadline > b->deadline;
+    if (a->slices != b->slices)
+        return a->slices > b->slices;
+    return a->id > b->id;
+}
+
+/**
+ * @brief Worker loop : resume the most urgent puzzle for one slice, queue it again if unfinished
+ */
+void PuzzleScheduler::work()
+{
+    while (true)
+    {
+        Job *job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            ready_condition.wait(lock, [this]
+                                 { return stopping || !ready.empty(); });
+            if (stopping)
+                return;
+            job = ready.top();
+            ready.pop();
+        }
+
+        bool expired = Clock::now() >= job->deadline;
+        bool done = expired || job->task.resume();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!done)
+        {
+            job->slices++;
+            ready.push(job);
+            ready_condition.notify_one();
+            continue;
+        }
+        ScheduledResult &result = results[job->id];
+        result.status = expired ? SearchStatus::Cancelled : job->task.status();
+        if (result.status == SearchStatus::Solved)
+            result.board = job->engine->getResult();
+        result.nodes = job->engine->getNodes();
+        result.elapsed = Clock::now() - job->submitted;
+        jobs[job->id].reset();
+        if (--pending == 0)
+            idle_condition.notify_all();
+    }
+}
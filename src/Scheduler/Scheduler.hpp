@@ -0,0 +1,68 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+#include "../Feasibility/Feasibility.hpp"
+#include "../SearchEngine/SearchEngine.hpp"
+#include "../Tile/Tile.hpp"
+
+struct ScheduledResult
+{
+    SearchStatus status = SearchStatus::Cancelled; // Cancelled when the deadline passed
+    std::vector<std::vector<Tile>> board;          // Filled when solved
+    uint64_t nodes = 0;
+    std::chrono::steady_clock::duration elapsed{}; // From submit to the end of the search
+};
+
+// Cooperative scheduler of many puzzles on a fixed set of worker threads. Every
+// puzzle is a SearchTask coroutine resumed for yield_every nodes at a time, the
+// highest priority first, then the earliest deadline, then the puzzle that ran the
+// fewest slices, so short puzzles finish before a long one gets many turns.
+// Infeasible puzzles never reach a worker.
+class PuzzleScheduler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    PuzzleScheduler(unsigned int workers = std::thread::hardware_concurrency(), uint64_t yield_every = 4096);
+    ~PuzzleScheduler();
+
+    std::size_t submit(int rows, int cols, const std::vector<TileType> &types, int priority = 0,
+                       Clock::time_point deadline = Clock::time_point::max());
+    void wait();
+    const ScheduledResult &getResult(std::size_t id) const { return results[id]; }
+    std::size_t size() const { return results.size(); }
+
+private:
+    struct Job
+    {
+        std::size_t id;
+        int priority;
+        Clock::time_point deadline, submitted;
+        uint64_t slices = 0; // Number of times the task was resumed
+        std::unique_ptr<SearchEngine> engine;
+        SearchTask task;
+    };
+    struct RunsLater
+    {
+        bool operator()(const Job *a, const Job *b) const;
+    };
+
+    uint64_t yield_every;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable ready_condition, idle_condition;
+    std::priority_queue<Job *, std::vector<Job *>, RunsLater> ready;
+    std::vector<std::unique_ptr<Job>> jobs; // Released once finished
+    std::deque<ScheduledResult> results;    // Stable references while jobs are added
+    std::size_t pending = 0;
+    bool stopping = false;
+
+    void work();
+};
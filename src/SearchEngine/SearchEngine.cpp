@@ -0,0 +1,472 @@
+#include <algorithm>
+#include "SearchEngine.hpp"
+
+/**
+ * @brief Construct a new Search Engine, every tile type starts with all its copies
+ *
+ * @param rows Board height
+ * @param cols Board width
+ * @param types Tile types of the puzzle
+ * @param config Cell and tile orders
+ * @param cancel Checked while searching, the search stops when it becomes true
+ */
+SearchEngine::SearchEngine(int rows, int cols, const std::vector<TileType> &types, const SearchConfig &config,
+                           const std::atomic<bool> *cancel, DeadStateTable *nogoods)
+    : rows(rows), cols(cols), types(types), config(config), cancel(cancel), board(rows * cols), placed(rows * cols, 0), fixed(rows * cols, -1)
+{
+    this->nogoods = (config.cell_order == CellOrder::RowMajor) ? nogoods : nullptr;
+    type_keys.resize(this->types.size());
+    type_checks.resize(this->types.size());
+    for (size_t type = 0; type < this->types.size(); type++)
+    {
+        this->types[type].remaining = this->types[type].count;
+        this->types[type].tile.used = true;
+        tileSignature(this->types[type].tile, type_keys[type], type_checks[type]);
+    }
+    buildCellOrder();
+    buildValueOrder(config.seed);
+}
+
+/**
+ * @brief Luby sequence 1, 1, 2, 1, 1, 2, 4, 1, 1, 2, 1, 1, 2, 4, 8, ...
+ *
+ * @param i index, starting at 1
+ * @return uint64_t
+ */
+uint64_t luby(uint64_t i)
+{
+    uint64_t size = 1, power = 1;
+    while (size < i)
+    {
+        size = 2 * size + 1;
+        power *= 2;
+    }
+    while (size != i)
+    {
+        size /= 2;
+        power /= 2;
+        if (i > size)
+            i -= size;
+    }
+    return power;
+}
+
+/**
+ * @brief splitmix64 step, the same seed always gives the same sequence on every platform
+ *
+ * @param state Generator state, updated
+ * @return uint64_t
+ */
+uint64_t nextRandom(uint64_t &state)
+{
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Keep a tile on a cell, every search only fills the other cells
+ *
+ * @param cell index of the cell
+ * @param type Tile type placed on the cell
+ */
+void SearchEngine::fixCell(int cell, int type)
+{
+    fixed[cell] = type;
+    // The row-major frontier signature assumes that every cell after the frontier is empty,
+    // it still holds when the fixed cells come first
+    for (int before = 0; before < cell; before++)
+    {
+        if (fixed[before] < 0)
+            nogoods = nullptr;
+    }
+    buildCellOrder();
+}
+
+void SearchEngine::buildCellOrder()
+{
+    cells.clear();
+    if (config.cell_order == CellOrder::ColumnMajor)
+    {
+        for (int col = 0; col < cols; col++)
+            for (int row = 0; row < rows; row++)
+                cells.push_back(row * cols + col);
+    }
+    else if (config.cell_order == CellOrder::FrameFirst)
+    {
+        int top = 0, left = 0, bottom = rows - 1, right = cols - 1;
+        while (top <= bottom && left <= right)
+        {
+            for (int col = left; col <= right; col++)
+                cells.push_back(top * cols + col);
+            for (int row = top + 1; row <= bottom; row++)
+                cells.push_back(row * cols + right);
+            for (int col = right - 1; col >= left && bottom > top; col--)
+                cells.push_back(bottom * cols + col);
+            for (int row = bottom - 1; row > top && right > left; row--)
+                cells.push_back(row * cols + left);
+            top++, left++, bottom--, right--;
+        }
+    }
+    else
+    {
+        for (int cell = 0; cell < rows * cols; cell++)
+            cells.push_back(cell);
+    }
+    cells.erase(std::remove_if(cells.begin(), cells.end(), [this](int cell)
+                               { return fixed[cell] >= 0; }),
+                cells.end());
+}
+
+void SearchEngine::buildValueOrder(uint64_t seed)
+{
+    values.clear();
+    for (int type = 0; type < static_cast<int>(types.size()); type++)
+        values.push_back(type);
+
+    if (config.value_order == ValueOrder::Reversed)
+    {
+        std::reverse(values.begin(), values.end());
+    }
+    else if (config.value_order == ValueOrder::MostFrequent)
+    {
+        std::stable_sort(values.begin(), values.end(), [this](int a, int b)
+                         { return types[a].count > types[b].count; });
+    }
+    else if (config.value_order == ValueOrder::Shuffled)
+    {
+        // Fisher-Yates with our own generator, std::shuffle differs between standard libraries
+        uint64_t state = seed;
+        for (int i = static_cast<int>(values.size()) - 1; i > 0; i--)
+        {
+            std::swap(values[i], values[nextRandom(state) % (i + 1)]);
+        }
+    }
+}
+
+/**
+ * @brief Run the search from a board holding only the fixed cells. With a restart schedule, every run is cut
+ * after its node budget and the next one starts with a new seeded tile order
+ *
+ * @return SearchStatus
+ */
+SearchStatus SearchEngine::run()
+{
+    total_nodes = 0;
+    restarts = 0;
+    if (config.restart_schedule == RestartSchedule::None)
+        return searchOnce(config.node_limit);
+
+    uint64_t state = config.seed;
+    double geometricLimit = static_cast<double>(std::max<uint64_t>(config.node_limit, 1));
+    for (uint64_t i = 1;; i++)
+    {
+        uint64_t limit = std::max<uint64_t>(config.node_limit, 1);
+        if (config.restart_schedule == RestartSchedule::Luby)
+            limit *= luby(i);
+        else
+        {
+            limit = static_cast<uint64_t>(geometricLimit);
+            geometricLimit *= config.restart_growth;
+        }
+        if (config.max_restarts && restarts == config.max_restarts)
+            limit = 0; // Last chance, run to completion
+
+        config.value_order = ValueOrder::Shuffled;
+        buildValueOrder(nextRandom(state));
+        SearchStatus status = searchOnce(limit);
+        if (status != SearchStatus::Cutoff)
+            return status;
+        restarts++;
+    }
+}
+
+/**
+ * @brief One search from a board holding only the fixed cells
+ *
+ * @param limit Node budget, 0 for no limit
+ * @return SearchStatus
+ */
+SearchStatus SearchEngine::searchOnce(uint64_t limit)
+{
+    node_limit = limit;
+    if (!prepare())
+        return SearchStatus::Exhausted;
+    SearchStatus status = search(0);
+    total_nodes += nodes;
+    return status;
+}
+
+/**
+ * @brief Empty the board, give back every copy and place the fixed cells
+ *
+ * @return false if the fixed cells do not fit together
+ */
+bool SearchEngine::prepare()
+{
+    nodes = 0;
+    frame = 0;
+    std::fill(placed.begin(), placed.end(), 0);
+    for (size_t type = 0; type < types.size(); type++)
+    {
+        types[type].remaining = types[type].count;
+    }
+    remaining_key = 0;
+    remaining_check = 0;
+    for (size_t type = 0; type < types.size(); type++)
+    {
+        remaining_key += type_keys[type] * static_cast<uint64_t>(types[type].count);
+        remaining_check += type_checks[type] * static_cast<uint64_t>(types[type].count);
+    }
+    for (int cell = 0; cell < rows * cols; cell++)
+    {
+        int type = fixed[cell];
+        char newFrame;
+        if (type < 0)
+            continue;
+        if (types[type].remaining == 0 || !fits(cell, types[type].tile, newFrame))
+            return false;
+        types[type].remaining--;
+        remaining_key -= type_keys[type];
+        remaining_check -= type_checks[type];
+        board[cell] = types[type].tile;
+        placed[cell] = 1;
+        frame = newFrame;
+    }
+    return true;
+}
+
+/**
+ * @brief Resumable search : the same walk as run() without restarts, node limit or nogoods,
+ * written as an iterative DFS that suspends every yield_every nodes
+ *
+ * @param yield_every Nodes between two suspensions, 0 to never suspend
+ * @return SearchTask resumed by its owner until done
+ */
+SearchTask SearchEngine::runCooperative(uint64_t yield_every)
+{
+    total_nodes = 0;
+    restarts = 0;
+    if (!prepare())
+        co_return SearchStatus::Exhausted;
+
+    const int depthCount = static_cast<int>(cells.size());
+    std::vector<std::size_t> next(depthCount + 1, 0); // Next value tried at every depth
+    std::vector<int> chosen(depthCount);
+    std::vector<char> frames(depthCount); // Frame color before the choice of every depth
+    int depth = 0;
+    while (depth < depthCount)
+    {
+        if (next[depth] == 0)
+        {
+            nodes++;
+            total_nodes = nodes;
+            if (cancel && (nodes & 1023) == 0 && cancel->load(std::memory_order_relaxed))
+                co_return SearchStatus::Cancelled;
+            if (yield_every && nodes % yield_every == 0)
+                co_yield nodes;
+        }
+
+        int cell = cells[depth];
+        bool advanced = false;
+        while (next[depth] < values.size())
+        {
+            int type = values[next[depth]++];
+            char newFrame;
+            if (types[type].remaining == 0 || !fits(cell, types[type].tile, newFrame))
+                continue;
+            types[type].remaining--;
+            board[cell] = types[type].tile;
+            placed[cell] = 1;
+            frames[depth] = frame;
+            chosen[depth] = type;
+            frame = newFrame;
+            next[++depth] = 0;
+            advanced = true;
+            break;
+        }
+        if (advanced)
+            continue;
+
+        if (depth == 0)
+            co_return SearchStatus::Exhausted;
+        depth--;
+        placed[cells[depth]] = 0;
+        types[chosen[depth]].remaining++;
+        frame = frames[depth];
+    }
+    co_return SearchStatus::Solved;
+}
+
+/**
+ * @brief The board found by run(), in the layout of MacMahonGame::result
+ *
+ * @return std::vector<std::vector<Tile>>
+ */
+std::vector<std::vector<Tile>> SearchEngine::getResult() const
+{
+    std::vector<std::vector<Tile>> result(rows, std::vector<Tile>(cols));
+    for (int cell = 0; cell < rows * cols; cell++)
+    {
+        result[cell / cols][cell % cols] = board[cell];
+    }
+    return result;
+}
+
+/**
+ * @brief Unused copies of every tile type, all zero once solved
+ *
+ * @return std::vector<int>
+ */
+std::vector<int> SearchEngine::getRemaining() const
+{
+    std::vector<int> remaining;
+    remaining.reserve(types.size());
+    for (const TileType &type : types)
+    {
+        remaining.push_back(type.remaining);
+    }
+    return remaining;
+}
+
+/**
+ * @brief Check a tile against the frame and every filled neighbour, whatever the fill order
+ *
+ * @param cell index of the cell
+ * @param tile tile to check
+ * @param newFrame Frame color once the tile is placed
+ * @return true if you can place the tile
+ */
+bool SearchEngine::fits(int cell, const Tile &tile, char &newFrame) const
+{
+    int row = cell / cols, col = cell % cols;
+    newFrame = frame;
+    auto onFrame = [&newFrame](char side)
+    {
+        if (newFrame == 0)
+            newFrame = side;
+        return side == newFrame;
+    };
+    if (row == 0 && !onFrame(tile.top))
+        return false;
+    if (col == 0 && !onFrame(tile.left))
+        return false;
+    if (row == rows - 1 && !onFrame(tile.bottom))
+        return false;
+    if (col == cols - 1 && !onFrame(tile.right))
+        return false;
+
+    if (row > 0 && placed[cell - cols] && board[cell - cols].bottom != tile.top)
+        return false;
+    if (col > 0 && placed[cell - 1] && board[cell - 1].right != tile.left)
+        return false;
+    if (row < rows - 1 && placed[cell + cols] && board[cell + cols].top != tile.bottom)
+        return false;
+    if (col < cols - 1 && placed[cell + 1] && board[cell + 1].left != tile.right)
+        return false;
+    return true;
+}
+
+/**
+ * @brief Backtracking over the configured cell order
+ *
+ * @param depth Number of filled cells
+ * @return SearchStatus
+ */
+SearchStatus SearchEngine::search(int depth)
+{
+    if (depth == static_cast<int>(cells.size()))
+        return SearchStatus::Solved;
+    if (cancel && (nodes & 1023) == 0 && cancel->load(std::memory_order_relaxed))
+        return SearchStatus::Cancelled;
+    if (node_limit && nodes >= node_limit)
+        return SearchStatus::Cutoff;
+    nodes++;
+
+    int cell = cells[depth];
+    // Nogoods at row boundaries, the same frontier signature as MacMahonGame::frontierSignature
+    uint64_t key = 0, check = 0;
+    bool memoized = nogoods && cell % cols == 0;
+    if (memoized)
+    {
+        frontierSignature(cell, key, check);
+        if (nogoods->contains(key, check))
+            return SearchStatus::Exhausted;
+    }
+
+    char previousFrame = frame;
+    for (int type : values)
+    {
+        char newFrame;
+        if (types[type].remaining == 0 || !fits(cell, types[type].tile, newFrame))
+            continue;
+        types[type].remaining--;
+        remaining_key -= type_keys[type];
+        remaining_check -= type_checks[type];
+        board[cell] = types[type].tile;
+        placed[cell] = 1;
+        frame = newFrame;
+
+        SearchStatus status = search(depth + 1);
+        if (status == SearchStatus::Solved)
+            return status;
+
+        frame = previousFrame;
+        placed[cell] = 0;
+        types[type].remaining++;
+        remaining_key += type_keys[type];
+        remaining_check += type_checks[type];
+        if (status != SearchStatus::Exhausted)
+            return status;
+    }
+    // Only a subtree explored to the end is a nogood, a cut off one is unknown
+    if (memoized)
+        nogoods->insert(key, check, cell);
+    return SearchStatus::Exhausted;
+}
+
+/**
+ * @brief Signature of the subproblem left at a row boundary of the row-major order
+ *
+ * @param cell First empty cell, a multiple of cols
+ */
+void SearchEngine::frontierSignature(int cell, uint64_t &key, uint64_t &check) const
+{
+    key = mixHash(remaining_key, static_cast<uint64_t>(cell));
+    check = mixHash(remaining_check, static_cast<uint64_t>(cell));
+    if (cell == 0)
+        return;
+    key = mixHash(key, board[0].top);
+    check = mixHash(check, board[0].top);
+    for (int above = cell - cols; above < cell; above++)
+    {
+        key = mixHash(key, board[above].bottom);
+        check = mixHash(check, board[above].bottom);
+    }
+}
+
+/**
+ * @brief Differently configured engines to race on the same puzzle
+ *
+ * @param size Number of engines
+ * @return std::vector<SearchConfig>
+ */
+std::vector<SearchConfig> defaultPortfolio(unsigned int size)
+{
+    std::vector<SearchConfig> portfolio = {
+        {"row-major/input", CellOrder::RowMajor, ValueOrder::Input},
+        {"frame-first/most-frequent", CellOrder::FrameFirst, ValueOrder::MostFrequent},
+        {"column-major/reversed", CellOrder::ColumnMajor, ValueOrder::Reversed},
+        {"row-major/luby-restarts", CellOrder::RowMajor, ValueOrder::Shuffled, 1, 1000, RestartSchedule::Luby},
+    };
+    const CellOrder orders[] = {CellOrder::RowMajor, CellOrder::FrameFirst, CellOrder::ColumnMajor};
+    const char *orderNames[] = {"row-major", "frame-first", "column-major"};
+    for (unsigned int seed = 1; portfolio.size() < size; seed++)
+    {
+        int order = seed % 3;
+        portfolio.push_back({std::string(orderNames[order]) + "/shuffled#" + std::to_string(seed), orders[order], ValueOrder::Shuffled, seed});
+    }
+    portfolio.resize(size);
+    return portfolio;
+}
@@ -0,0 +1,150 @@
+#pragma once
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <vector>
+#include "../Tile/Tile.hpp"
+#include "../DeadStateTable/DeadStateTable.hpp"
+
+enum class CellOrder
+{
+    RowMajor,    // Same walk as MacMahonGame::solve
+    ColumnMajor, // Column by column
+    FrameFirst   // Ring by ring, clockwise from the top-left corner
+};
+
+enum class ValueOrder
+{
+    Input,        // Tile types in order of first appearance in the file
+    Reversed,     // Last appearing tile types first
+    MostFrequent, // Tile types with the most copies first
+    Shuffled      // Seeded shuffle, reproducible
+};
+
+enum class RestartSchedule
+{
+    None,     // A single run
+    Luby,     // node_limit times 1, 1, 2, 1, 1, 2, 4, ...
+    Geometric // node_limit times restart_growth^i
+};
+
+enum class SearchStatus
+{
+    Solved,
+    Exhausted, // Every branch was explored, there is no solution
+    Cutoff,    // The node limit was reached
+    Cancelled  // Another solver asked to stop
+};
+
+struct SearchConfig
+{
+    std::string name;
+    CellOrder cell_order = CellOrder::RowMajor;
+    ValueOrder value_order = ValueOrder::Input;
+    uint64_t seed = 0;
+    uint64_t node_limit = 0; // 0 for no limit, unit of the schedule with restarts
+    RestartSchedule restart_schedule = RestartSchedule::None;
+    double restart_growth = 2.0; // Geometric schedule only
+    unsigned int max_restarts = 0; // 0 for no limit
+};
+
+// Coroutine of a resumable search, suspended every few nodes so one thread can
+// interleave many searches. Move only, the coroutine frame is destroyed with it.
+class SearchTask
+{
+public:
+    struct promise_type
+    {
+        SearchStatus status = SearchStatus::Cancelled;
+
+        SearchTask get_return_object() { return SearchTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(uint64_t) noexcept { return {}; }
+        void return_value(SearchStatus value) { status = value; }
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    SearchTask() = default;
+    SearchTask(SearchTask &&other) noexcept : handle(other.handle) { other.handle = nullptr; }
+    SearchTask &operator=(SearchTask &&other) noexcept
+    {
+        if (this != &other)
+        {
+            if (handle)
+                handle.destroy();
+            handle = other.handle;
+            other.handle = nullptr;
+        }
+        return *this;
+    }
+    SearchTask(const SearchTask &) = delete;
+    SearchTask &operator=(const SearchTask &) = delete;
+    ~SearchTask()
+    {
+        if (handle)
+            handle.destroy();
+    }
+
+    // Run until the next suspension, return true once the search is over
+    bool resume()
+    {
+        if (handle && !handle.done())
+            handle.resume();
+        return done();
+    }
+    bool done() const { return !handle || handle.done(); }
+    SearchStatus status() const { return handle ? handle.promise().status : SearchStatus::Cancelled; }
+
+private:
+    explicit SearchTask(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+    std::coroutine_handle<promise_type> handle = nullptr;
+};
+
+// Backtracking solver over its own board and tile type counters, configurable
+// cell and tile orders. Several engines can run on the same puzzle concurrently.
+class SearchEngine
+{
+public:
+    SearchEngine(int rows, int cols, const std::vector<TileType> &types, const SearchConfig &config,
+                 const std::atomic<bool> *cancel = nullptr, DeadStateTable *nogoods = nullptr);
+
+    void fixCell(int cell, int type);
+    SearchStatus run();
+    SearchTask runCooperative(uint64_t yield_every);
+    std::vector<std::vector<Tile>> getResult() const;
+    std::vector<int> getRemaining() const;
+    uint64_t getNodes() const { return total_nodes; }
+    unsigned int getRestarts() const { return restarts; }
+
+private:
+    int rows, cols;
+    std::vector<TileType> types;
+    SearchConfig config;
+    const std::atomic<bool> *cancel;
+    DeadStateTable *nogoods; // Only used with the row-major order, shared by the restarts
+    std::vector<int> cells;  // Cells in the order they are filled
+    std::vector<int> values; // Tile type indexes in the order they are tried
+    std::vector<Tile> board;
+    std::vector<char> placed;
+    std::vector<int> fixed;  // Tile type kept on every cell, -1 for a cell to search
+    char frame = 0; // Frame color, 0 while no border cell is filled
+    uint64_t nodes = 0, node_limit = 0, total_nodes = 0;
+    unsigned int restarts = 0;
+    std::vector<uint64_t> type_keys, type_checks;
+    uint64_t remaining_key = 0, remaining_check = 0;
+
+    void buildCellOrder();
+    void buildValueOrder(uint64_t seed);
+    bool fits(int cell, const Tile &tile, char &newFrame) const;
+    bool prepare();
+    SearchStatus searchOnce(uint64_t limit);
+    SearchStatus search(int depth);
+    void frontierSignature(int cell, uint64_t &key, uint64_t &check) const;
+};
+
+std::vector<SearchConfig> defaultPortfolio(unsigned int size);
+uint64_t nextRandom(uint64_t &state);
+uint64_t luby(uint64_t i);
@@ -0,0 +1,131 @@
+#include <fstream>
+#include <sstream>
+#include "SolutionCache.hpp"
+
+/**
+ * @brief Construct a new Solution Cache, reading the backing file if any
+ *
+ * @param capacity Maximum number of puzzles kept in memory
+ * @param path On-disk file, empty to keep the cache in memory only
+ */
+SolutionCache::SolutionCache(std::size_t capacity, const std::string &path)
+    : capacity(capacity == 0 ? 1 : capacity), path(path)
+{
+    load();
+}
+
+/**
+ * @brief Destroy the Solution Cache, flushing it to disk before
+ */
+SolutionCache::~SolutionCache()
+{
+    save();
+}
+
+/**
+ * @brief Find the outcome of a puzzle and mark it as recently used
+ *
+ * @param fingerprint Canonical fingerprint of the puzzle
+ * @param entry Filled with the stored outcome on hit
+ * @param transform Only match an entry stored with these quarter turns, -1 for any rotation
+ * @return true if the puzzle is in the cache
+ */
+bool SolutionCache::lookup(const std::string &fingerprint, CacheEntry &entry, int transform)
+{
+    auto it = index.find(fingerprint);
+    if (it == index.end() || (transform >= 0 && it->second->second.transform != transform))
+    {
+        misses++;
+        return false;
+    }
+    entries.splice(entries.begin(), entries, it->second);
+    entry = it->second->second;
+    hits++;
+    return true;
+}
+
+/**
+ * @brief Insert or refresh the outcome of a puzzle, evicting the least recently used one
+ *
+ * @param fingerprint Canonical fingerprint of the puzzle
+ * @param entry Outcome to store
+ */
+void SolutionCache::store(const std::string &fingerprint, const CacheEntry &entry)
+{
+    auto it = index.find(fingerprint);
+    if (it != index.end())
+    {
+        it->second->second = entry;
+        entries.splice(entries.begin(), entries, it->second);
+        return;
+    }
+    entries.emplace_front(fingerprint, entry);
+    index[fingerprint] = entries.begin();
+    if (entries.size() > capacity)
+    {
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+}
+
+/**
+ * @brief Read the backing file. Malformed lines are ignored, the cache is only a hint.
+ *
+ * Format of a line : fingerprint outcome(S|U|C) count transform [permutation...]
+ */
+void SolutionCache::load()
+{
+    if (path.empty())
+        return;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream lineStream(line);
+        std::string fingerprint;
+        char outcome;
+        CacheEntry entry;
+        if (!(lineStream >> fingerprint >> outcome >> entry.count >> entry.transform))
+            continue;
+        if (outcome == 'S')
+            entry.outcome = CacheOutcome::Solved;
+        else if (outcome == 'U')
+            entry.outcome = CacheOutcome::Unsolvable;
+        else if (outcome == 'C')
+            entry.outcome = CacheOutcome::Count;
+        else
+            continue;
+        int tileIndex;
+        while (lineStream >> tileIndex)
+        {
+            entry.permutation.push_back(tileIndex);
+        }
+        // The file is written from the oldest to the newest entry
+        store(fingerprint, entry);
+    }
+}
+
+/**
+ * @brief Write the whole cache to the backing file
+ */
+void SolutionCache::save() const
+{
+    if (path.empty())
+        return;
+    std::ofstream file(path, std::ios::trunc);
+    for (auto it = entries.rbegin(); it != entries.rend(); ++it)
+    {
+        const CacheEntry &entry = it->second;
+        char outcome = 'C';
+        if (entry.outcome == CacheOutcome::Solved)
+            outcome = 'S';
+        else if (entry.outcome == CacheOutcome::Unsolvable)
+            outcome = 'U';
+        file << it->first << ' ' << outcome << ' ' << entry.count << ' ' << entry.transform;
+        for (int tileIndex : entry.permutation)
+        {
+            file << ' ' << tileIndex;
+        }
+        file << '\n';
+    }
+}
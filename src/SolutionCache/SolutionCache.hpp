@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+enum class CacheOutcome
+{
+    Solved,     // permutation holds the canonical tile index of every cell
+    Unsolvable, // the search was exhaustive and found nothing
+    Count       // count holds the number of distinct solutions
+};
+
+struct CacheEntry
+{
+    CacheOutcome outcome = CacheOutcome::Unsolvable;
+    unsigned long long count = 0;
+    int transform = 0; // Quarter turns from the stored puzzle to its fingerprint, tells a rotated hit apart
+    std::vector<int> permutation;
+};
+
+// In-memory LRU of solver outcomes keyed by puzzle fingerprint, optionally
+// backed by a text file so results survive between runs.
+class SolutionCache
+{
+public:
+    SolutionCache(std::size_t capacity = 1024, const std::string &path = "");
+    ~SolutionCache();
+
+    bool lookup(const std::string &fingerprint, CacheEntry &entry, int transform = -1);
+    void store(const std::string &fingerprint, const CacheEntry &entry);
+    void load();
+    void save() const;
+
+    std::size_t size() const { return entries.size(); }
+    std::size_t getHits() const { return hits; }
+    std::size_t getMisses() const { return misses; }
+
+private:
+    using Node = std::pair<std::string, CacheEntry>;
+
+    std::size_t capacity;
+    std::string path;
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+    std::list<Node> entries; // Most recently used first
+    std::unordered_map<std::string, std::list<Node>::iterator> index;
+};
@@ -0,0 +1,37 @@
+#include "SolverContext.hpp"
+
+/**
+ * @brief Reentrant solve : every piece of state lives in the context, so any number of calls
+ * may run at the same time on the same puzzle. Infeasible puzzles are rejected without searching.
+ *
+ * @param puzzle Puzzle to solve, never modified
+ * @param context State of this call, reset first
+ * @param config Cell and tile orders, restarts (row-major in the input order by default)
+ * @return true if there is a solution
+ */
+bool solvePuzzle(const Puzzle &puzzle, SolverContext &context, const SearchConfig &config)
+{
+    context.board.clear();
+    context.remaining.clear();
+    for (const TileType &type : puzzle.getTileTypes())
+    {
+        context.remaining.push_back(type.count);
+    }
+    context.nodes = 0;
+    context.restarts = 0;
+    if (!puzzle.getFeasibility().feasible())
+    {
+        context.status = SearchStatus::Exhausted;
+        return false;
+    }
+
+    SearchEngine engine(puzzle.getRows(), puzzle.getCols(), puzzle.getTileTypes(), config, context.cancel, context.dead_states);
+    context.status = engine.run();
+    context.nodes = engine.getNodes();
+    context.restarts = engine.getRestarts();
+    context.remaining = engine.getRemaining();
+    if (context.status != SearchStatus::Solved)
+        return false;
+    context.board = engine.getResult();
+    return true;
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "../Puzzle/Puzzle.hpp"
+#include "../SearchEngine/SearchEngine.hpp"
+#include "../DeadStateTable/DeadStateTable.hpp"
+
+// Per-call state of a library solve : board, unused copies of every tile type and
+// statistics. One context per concurrent solve, the Puzzle itself is shared read-only.
+struct SolverContext
+{
+    std::vector<std::vector<Tile>> board; // Filled when solved
+    std::vector<int> remaining;           // Unused copies of every tile type when the search stopped
+    SearchStatus status = SearchStatus::Exhausted;
+    uint64_t nodes = 0;
+    unsigned int restarts = 0;
+
+    const std::atomic<bool> *cancel = nullptr; // Optional, the search stops once it becomes true
+    DeadStateTable *dead_states = nullptr;     // Optional, may be shared between contexts
+};
+
+bool solvePuzzle(const Puzzle &puzzle, SolverContext &context, const SearchConfig &config = SearchConfig());
@@ -0,0 +1,18 @@
+#pragma once
+
+struct Tile
+{
+    char top, right, bottom, left;
+    bool used = false;
+    Tile(char l = ' ', char t = ' ', char r = ' ', char b = ' ')
+        : top(t), right(r), bottom(b), left(l) {}
+};
+
+struct TileType
+{
+    // Identical tiles share a type, copies are interchangeable
+    Tile tile;
+    int count = 1;
+    int remaining = 1;
+    TileType(const Tile &tile) : tile(tile) {}
+};